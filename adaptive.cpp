@@ -0,0 +1,193 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "adaptive.h"
+#include "decode_table.h"
+#include "encode_table.h"
+
+#include <algorithm>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+
+namespace
+{
+
+enum
+{
+	// Rebuild interval while the code settles, doubled up to the real one
+	ADAPTIVE_FIRST_INTERVAL = 64,
+	// Counts are halved once they add up to this many intervals
+	ADAPTIVE_HISTORY = 32
+};
+
+} // namespace
+
+AdaptiveModel::AdaptiveModel(unsigned int interval_bits, unsigned int max_code_length)
+	: interval(1u << interval_bits), max_code_length(max_code_length)
+{
+	// No count ever drops below one, so every byte can be coded at any time
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		counts[i] = 1;
+	total = HUFFMAN_NUM_SYMBOLS;
+
+	next_interval = std::min<unsigned int>(ADAPTIVE_FIRST_INTERVAL, interval);
+	until_rebuild = next_interval;
+
+	// A flat code fits the equal counts, no need to build one for every
+	// stream
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		lengths_[i] = i < HUFFMAN_NUM_SYMBOLS - 2 ? 8 : 9;
+}
+
+void AdaptiveModel::rebuild()
+{
+	if (total > static_cast<unsigned long long>(interval) * ADAPTIVE_HISTORY)
+	{
+		total = 0;
+		for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		{
+			counts[i] = (counts[i] + 1) / 2;
+			total += counts[i];
+		}
+	}
+
+	builder.build(counts, max_code_length, lengths_);
+
+	if (next_interval < interval)
+		next_interval *= 2;
+	until_rebuild = next_interval;
+}
+
+void huffman_compress_adaptive(std::istream& in, OFileBitstream& stream, unsigned int interval_bits,
+	unsigned int max_code_length, Stats* stats)
+{
+	const unsigned long long start_bits = stream.bitsWritten();
+
+	stream.push_back(static_cast<unsigned char>(interval_bits));
+	stream.push_back(static_cast<unsigned char>(max_code_length));
+
+	AdaptiveModel model(interval_bits, max_code_length);
+	EncodeTable table(model.lengths());
+
+	PhaseTimer timer(stats, PHASE_ENCODE);
+
+	std::streambuf* buf = in.rdbuf();
+	char chunk[64 * 1024];
+	unsigned long long symbols = 0;
+
+	// Waits for a single byte, then codes whatever else is ready with it
+	while (buf->sgetc() != std::char_traits<char>::eof())
+	{
+		std::streamsize ready = std::max<std::streamsize>(buf->in_avail(), 1);
+		std::streamsize n = buf->sgetn(chunk, std::min<std::streamsize>(ready, sizeof(chunk)));
+
+		for (std::streamsize i = 0; i < n; ++i)
+		{
+			unsigned char c = static_cast<unsigned char>(chunk[i]);
+			table.encode(stream, c);
+			if (model.update(c))
+				table.build(model.lengths());
+		}
+
+		symbols += n;
+		if (stats != 0)
+			stats->progress(symbols, 0);
+
+		if (buf->in_avail() <= 0)
+			stream.flush();
+	}
+
+	table.encode(stream, HUFFMAN_EOF);
+
+	if (stats != 0)
+	{
+		unsigned long long bits = stream.bitsWritten() - start_bits;
+		stats->bytes_in += symbols;
+		stats->bytes_out += (bits + 7) / 8;
+		stats->symbols += symbols;
+		stats->bits += bits - 16; // Not the two header bytes
+	}
+}
+
+void huffman_uncompress_adaptive(IFileBitstream& stream, std::ostream& output, Stats* stats)
+{
+	const unsigned long long start_pos = stream.bytesConsumed();
+
+	unsigned int interval_bits = stream.nextChar();
+	unsigned int max_code_length = stream.nextChar();
+	if (interval_bits < ADAPTIVE_MIN_INTERVAL_BITS || interval_bits > ADAPTIVE_MAX_INTERVAL_BITS)
+		throw std::ios_base::failure("invalid rebuild interval");
+	if (max_code_length < HUFFMAN_MIN_CODE_LENGTH_LIMIT || max_code_length > HUFFMAN_MAX_CODE_LENGTH)
+		throw std::ios_base::failure("invalid code length limit");
+
+	AdaptiveModel model(interval_bits, max_code_length);
+	DecodeTable table(model.lengths());
+
+	PhaseTimer timer(stats, PHASE_DECODE);
+
+	char buffer[64 * 1024];
+	size_t buffered = 0;
+	unsigned long long symbols = 0;
+
+	while (true)
+	{
+		unsigned int val = table.decode(stream);
+		if (val >= HUFFMAN_EOF)
+		{
+			if (val != HUFFMAN_EOF)
+				throw std::ios_base::failure("invalid code");
+			break;
+		}
+
+		buffer[buffered++] = static_cast<char>(val);
+		if (model.update(val))
+			table.build(model.lengths());
+
+		// Don't sit on decoded bytes while waiting for more input
+		const bool drained = stream.drained();
+		if (buffered == sizeof(buffer) || drained)
+		{
+			output.write(buffer, buffered);
+			if (drained)
+				output.flush();
+			symbols += buffered;
+			buffered = 0;
+
+			if (stats != 0)
+				stats->progress(stream.bytesConsumed() - start_pos, 0);
+		}
+	}
+
+	output.write(buffer, buffered);
+	symbols += buffered;
+
+	if (stats != 0)
+	{
+		stats->bytes_in += stream.bytesConsumed() - start_pos;
+		stats->bytes_out += symbols;
+		stats->symbols += symbols;
+		stats->bits += (stream.bytesConsumed() - start_pos - 2) * 8; // Not the two header bytes
+	}
+}
@@ -0,0 +1,109 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_ADAPTIVE_H
+#define YURIKS_ADAPTIVE_H
+
+#include "bitstream.h"
+#include "canonical.h"
+#include "stats.h"
+
+#include <iosfwd>
+
+// One-pass coding for live streams. Encoder and decoder start from the same
+// flat code and rebuild it from their running symbol counts at the same
+// points, so no code is ever sent and every byte can be written as soon as
+// it is read.
+//
+// FORMAT_ADAPTIVE layout, after the format header: u8 log2 of the rebuild
+// interval, u8 longest code length, then the coded bytes ending with EOF.
+
+enum
+{
+	ADAPTIVE_MIN_INTERVAL_BITS = 6,
+	ADAPTIVE_MAX_INTERVAL_BITS = 20,
+	// Rebuilding the code costs about as much as coding a few thousand
+	// bytes, so it isn't done much more often than this
+	ADAPTIVE_DEFAULT_INTERVAL_BITS = 14,
+	// Bytes that haven't shown up yet still need a code. The longer they
+	// can be, the less of the code space they take from the others.
+	ADAPTIVE_DEFAULT_MAX_CODE_LENGTH = HUFFMAN_MAX_CODE_LENGTH
+};
+
+// Running counts of the symbols coded so far, and the code built from them.
+// The code is rebuilt after 64, 128, ... symbols while it settles, then
+// every interval symbols. Counts are halved as they grow, so the code keeps
+// following the data.
+class AdaptiveModel
+{
+public:
+	AdaptiveModel(unsigned int interval_bits, unsigned int max_code_length);
+
+	// Counts a coded symbol. Returns true if that rebuilt the code.
+	bool update(unsigned int symbol);
+
+	const unsigned char* lengths() const;
+
+private:
+	void rebuild();
+
+	unsigned long long counts[HUFFMAN_NUM_SYMBOLS];
+	unsigned long long total;
+	unsigned char lengths_[HUFFMAN_NUM_SYMBOLS];
+
+	unsigned int interval;
+	unsigned int next_interval;
+	unsigned int until_rebuild;
+	unsigned int max_code_length;
+	CodeLengthBuilder builder;
+};
+
+inline bool AdaptiveModel::update(unsigned int symbol)
+{
+	++counts[symbol];
+	++total;
+
+	if (--until_rebuild != 0)
+		return false;
+
+	rebuild();
+	return true;
+}
+
+inline const unsigned char* AdaptiveModel::lengths() const
+{
+	return lengths_;
+}
+
+// Codes `in` until its end. Whenever `in` has no more input ready, what
+// has been coded so far is flushed to the output, so a reader on the other
+// end of a pipe doesn't wait for a buffer to fill up.
+void huffman_compress_adaptive(std::istream& in, OFileBitstream& stream, unsigned int interval_bits,
+	unsigned int max_code_length, Stats* stats = 0);
+// Expects the format header to have been consumed by read_format already.
+// Use a live IFileBitstream to decode a stream as it arrives; output is
+// then flushed whenever the input runs dry.
+// Throws std::ios_base::failure on corrupt input.
+void huffman_uncompress_adaptive(IFileBitstream& stream, std::ostream& output, Stats* stats = 0);
+
+#endif // YURIKS_ADAPTIVE_H
@@ -0,0 +1,387 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "batch.h"
+#include "block.h"
+#include "file_io.h"
+#include "huffman.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace
+{
+
+const char COMPRESSED_SUFFIX[] = ".hz";
+
+// A file being coded, shared by its block tasks. Whichever task finishes
+// the last block writes out or closes the output.
+struct FileJob
+{
+	explicit FileJob(const BatchFile& file) : file(file), created(false), out_data(0), remaining(0) {}
+
+	const BatchFile& file;
+	InputFile in;
+	OutputFileBuf out;
+	bool created;
+
+	// Compression keeps the blocks until they can be written in order,
+	// decompression writes them straight into the mapped output.
+	std::vector<std::vector<unsigned char> > blocks;
+	ContainerIndex index;
+	unsigned char* out_data;
+
+	std::atomic<size_t> remaining;
+	std::mutex mutex;
+	std::string error;
+};
+
+typedef std::shared_ptr<FileJob> Job;
+
+class Batch
+{
+public:
+	Batch(const BatchOptions& options, std::ostream& errors);
+
+	BatchResult run(const std::vector<BatchFile>& files);
+
+private:
+	void startFile(unsigned int worker, const BatchFile& file);
+	void codeBlock(unsigned int worker, Job job, size_t i);
+	void finishFile(FileJob& job);
+	void fail(FileJob& job, const std::string& error);
+
+	const BatchOptions& options;
+	Stats* stats;
+	std::ostream& errors;
+	std::mutex errors_mutex;
+
+	WorkStealingPool pool;
+	std::vector<BlockTables> tables;
+
+	std::atomic<size_t> failed;
+	std::atomic<unsigned long long> bytes_in;
+	std::atomic<unsigned long long> bytes_out;
+	// Input bytes coded so far, for progress
+	std::atomic<unsigned long long> done;
+};
+
+Batch::Batch(const BatchOptions& options, std::ostream& errors)
+	: options(options), stats(options.container.block.stats), errors(errors),
+	pool(options.container.threads), tables(pool.size()),
+	failed(0), bytes_in(0), bytes_out(0), done(0)
+{
+}
+
+BatchResult Batch::run(const std::vector<BatchFile>& files)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Largest first, so the big files aren't left for last
+	std::vector<std::pair<unsigned long long, size_t> > order(files.size());
+	unsigned long long total = 0;
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		unsigned long long size = 0;
+		regular_file_size(files[i].in_name, size);
+		order[i] = std::make_pair(size, i);
+		total += size;
+	}
+	std::stable_sort(order.begin(), order.end(), [](const std::pair<unsigned long long, size_t>& a, const std::pair<unsigned long long, size_t>& b) {
+		return a.first > b.first;
+	});
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		const BatchFile& file = files[order[i].second];
+		pool.submit([this, &file](unsigned int worker) { startFile(worker, file); });
+	}
+
+	while (!pool.waitFor(std::chrono::milliseconds(100)))
+	{
+		if (stats != 0)
+			stats->progress(done, total);
+	}
+	if (stats != 0)
+		stats->progress(total, total);
+
+	BatchResult result;
+	result.files = files.size();
+	result.failed = failed;
+	result.bytes_in = bytes_in;
+	result.bytes_out = bytes_out;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+void Batch::startFile(unsigned int worker, const BatchFile& file)
+{
+	Job job(new FileJob(file));
+
+	if (!job->in.open(file.in_name.c_str()) || !job->in.mapped())
+	{
+		fail(*job, "Couldn't open " + file.in_name);
+		return;
+	}
+	if (!job->out.open(file.out_name.c_str()))
+	{
+		fail(*job, "Couldn't open " + file.out_name);
+		return;
+	}
+	job->created = true;
+
+	size_t count;
+	if (!options.decompress)
+	{
+		const size_t block_size = options.container.block_size;
+		count = static_cast<size_t>((job->in.size() + block_size - 1) / block_size);
+		job->blocks.resize(count);
+	}
+	else
+	{
+		const unsigned char* data = job->in.data();
+		try
+		{
+			if (job->in.size() < 3 || data[0] != 'H' || data[1] != 'Z' || data[2] != FORMAT_BLOCKS)
+				throw std::ios_base::failure("not compressed in blocks");
+			job->index = read_container_index(data, job->in.size());
+		}
+		catch (std::ios_base::failure& e)
+		{
+			fail(*job, "Couldn't read " + file.in_name + ": " + e.what());
+			return;
+		}
+
+		count = job->index.blockCount();
+		if (job->index.raw_size != 0)
+		{
+			job->out_data = job->out.map(job->index.raw_size);
+			if (job->out_data == 0)
+			{
+				fail(*job, "Couldn't write " + file.out_name);
+				return;
+			}
+		}
+	}
+
+	if (count == 0)
+	{
+		finishFile(*job);
+		return;
+	}
+
+	// The other blocks are left for this worker to take newest first, or
+	// for idle ones to steal
+	job->remaining = count;
+	for (size_t i = count - 1; i > 0; --i)
+		pool.submit([this, job, i](unsigned int worker) { codeBlock(worker, job, i); });
+	codeBlock(worker, job, 0);
+}
+
+void Batch::codeBlock(unsigned int worker, Job job, size_t i)
+{
+	const unsigned char* data = job->in.data();
+	unsigned long long in_size;
+
+	try
+	{
+		if (!options.decompress)
+		{
+			const size_t block_size = options.container.block_size;
+			size_t pos = i * block_size;
+			size_t raw_size = static_cast<size_t>(std::min<unsigned long long>(block_size, job->in.size() - pos));
+
+			std::vector<unsigned char>& block = job->blocks[i];
+			block.resize(compressed_block_bound(raw_size));
+			block.resize(compress_block(data + pos, raw_size, options.container.block, &block[0], tables[worker]));
+			in_size = raw_size;
+		}
+		else
+		{
+			const ContainerIndex& index = job->index;
+			decompress_block_span(data, index, i, i + 1, job->out_data + index.blocks[i].raw_offset, tables[worker], stats);
+			in_size = index.blocks[i+1].offset - index.blocks[i].offset;
+		}
+	}
+	catch (std::ios_base::failure& e)
+	{
+		std::lock_guard<std::mutex> lock(job->mutex);
+		if (job->error.empty())
+			job->error = "Couldn't read " + job->file.in_name + ": " + e.what();
+		in_size = 0;
+	}
+
+	done += in_size;
+
+	if (--job->remaining == 0)
+		finishFile(*job);
+}
+
+void Batch::finishFile(FileJob& job)
+{
+	if (!job.error.empty())
+	{
+		fail(job, job.error);
+		return;
+	}
+
+	if (!options.decompress)
+	{
+		std::ostream out(&job.out);
+		write_blocks(out, options.container.block_size, job.blocks);
+		out.flush();
+		if (!out)
+		{
+			fail(job, "Couldn't write " + job.file.out_name);
+			return;
+		}
+	}
+	if (!job.out.close())
+	{
+		fail(job, "Couldn't write " + job.file.out_name);
+		return;
+	}
+
+	unsigned long long in_size = job.in.size();
+	unsigned long long out_size = 0;
+	regular_file_size(job.file.out_name, out_size);
+	job.in.close();
+
+	bytes_in += in_size;
+	bytes_out += out_size;
+	if (stats != 0)
+	{
+		stats->bytes_in += in_size;
+		stats->bytes_out += out_size;
+	}
+}
+
+void Batch::fail(FileJob& job, const std::string& error)
+{
+	job.out.close();
+	job.in.close();
+	if (job.created)
+		std::remove(job.file.out_name.c_str());
+
+	++failed;
+	std::lock_guard<std::mutex> lock(errors_mutex);
+	errors << error << std::endl;
+}
+
+// Name of the output file, relative to the output directory
+std::string output_name(const std::string& name, bool decompress)
+{
+	const size_t suffix_size = sizeof(COMPRESSED_SUFFIX) - 1;
+
+	if (!decompress)
+		return name + COMPRESSED_SUFFIX;
+	if (name.size() > suffix_size && name.compare(name.size() - suffix_size, suffix_size, COMPRESSED_SUFFIX) == 0)
+		return name.substr(0, name.size() - suffix_size);
+	return name + ".out";
+}
+
+} // namespace
+
+BatchOptions::BatchOptions()
+	: decompress(false)
+{
+}
+
+std::vector<BatchFile> list_batch(const std::string& input, const std::string& out_dir, bool decompress)
+{
+	std::vector<std::string> names;
+	std::vector<BatchFile> files;
+
+	const bool from_dir = is_directory(input);
+	if (from_dir)
+	{
+		if (!list_files(input, names))
+			throw std::ios_base::failure("can't list the directory");
+	}
+	else
+	{
+		std::ifstream list_file;
+		if (input != "-")
+		{
+			list_file.open(input.c_str());
+			if (!list_file)
+				throw std::ios_base::failure("can't open the file list");
+		}
+		std::istream& list = input == "-" ? std::cin : list_file;
+
+		std::string line;
+		while (std::getline(list, line))
+		{
+			if (!line.empty() && line[line.size() - 1] == '\r')
+				line.erase(line.size() - 1);
+			if (!line.empty())
+				names.push_back(line);
+		}
+	}
+
+	if (!make_directories(out_dir))
+		throw std::ios_base::failure("can't create " + out_dir);
+
+	std::set<std::string> outputs;
+	for (size_t i = 0; i < names.size(); ++i)
+	{
+		BatchFile file;
+		std::string relative = names[i];
+
+		if (from_dir)
+		{
+			file.in_name = input + "/" + names[i];
+		}
+		else
+		{
+			file.in_name = names[i];
+			std::string::size_type slash = relative.find_last_of("/\\");
+			if (slash != std::string::npos)
+				relative = relative.substr(slash + 1);
+		}
+		file.out_name = out_dir + "/" + output_name(relative, decompress);
+
+		if (!outputs.insert(file.out_name).second)
+			throw std::ios_base::failure("more than one file would be written to " + file.out_name);
+		if (!make_directories(file.out_name.substr(0, file.out_name.find_last_of('/'))))
+			throw std::ios_base::failure("can't create the directory for " + file.out_name);
+
+		files.push_back(file);
+	}
+
+	return files;
+}
+
+BatchResult run_batch(const std::vector<BatchFile>& files, const BatchOptions& options, std::ostream& errors)
+{
+	Batch batch(options, errors);
+	return batch.run(files);
+}
@@ -0,0 +1,74 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_BATCH_H
+#define YURIKS_BATCH_H
+
+#include "container.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct BatchFile
+{
+	std::string in_name;
+	std::string out_name;
+};
+
+struct BatchOptions
+{
+	BatchOptions();
+
+	// threads is the size of the pool. block.stats gets the counters of
+	// every file, and its progress is reported from the calling thread.
+	ContainerOptions container;
+	bool decompress;
+};
+
+struct BatchResult
+{
+	size_t files;
+	size_t failed;
+	unsigned long long bytes_in;
+	unsigned long long bytes_out;
+	double seconds;
+};
+
+// Lists the files to code from `input`, which is either a directory, whose
+// files keep their relative paths under out_dir, or a file with one name
+// per line ("-" for standard input), whose files go straight into out_dir.
+// Compressed files get a ".hz" suffix, which decompression takes off again.
+// Creates the directories the outputs need.
+// Throws std::ios_base::failure if the input can't be read or two inputs
+// would be written to the same file.
+std::vector<BatchFile> list_batch(const std::string& input, const std::string& out_dir, bool decompress);
+
+// Compresses (to FORMAT_BLOCKS) or decompresses every file on one
+// work-stealing pool, with one set of block tables per worker. Files are
+// started largest first and every block is a task of its own, so a few big
+// files among many small ones still keep all the workers busy. A file that
+// fails is reported to `errors` and its output removed; the others go on.
+BatchResult run_batch(const std::vector<BatchFile>& files, const BatchOptions& options, std::ostream& errors);
+
+#endif // YURIKS_BATCH_H
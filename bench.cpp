@@ -0,0 +1,1513 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Benchmarks the codec stages on synthetic corpora, apart from the command
+// line tool. Corpora are generated from a fixed seed, so runs on different
+// builds see the same bytes and their results can be compared.
+//
+// Usage: huffman_bench [--size=N[K|M]] [--min-time=SECONDS] [--corpus=NAME]
+//                      [--piece=N[K|M]] [--stage=NAME] [--json]
+//        huffman_bench --large=N[K|M|G] [--stage=FORMAT] [--json]
+//
+// --large instead checks that inputs of any size, past 4 GiB too, come back
+// the same from every format, with a made-up input that takes neither disk
+// space nor memory.
+
+#include "huffman.h"
+#include "adaptive.h"
+#include "bit_kernels.h"
+#include "bitstream.h"
+#include "block.h"
+#include "codec.h"
+#include "container.h"
+#include "histogram.h"
+#include "shared_table.h"
+#include "static_table.h"
+#include "text_table.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#	include <psapi.h>
+#	pragma comment(lib, "psapi.lib")
+#else
+#	include <sys/resource.h>
+#endif
+
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Corpora
+
+// xorshift64*, so the corpora don't depend on the standard library's
+// distributions
+class Random
+{
+public:
+	explicit Random(unsigned long long seed) : state(seed) {}
+
+	unsigned long long next()
+	{
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return state * 2685821657736338717ULL;
+	}
+
+	// Uniform in [0, 1)
+	double real()
+	{
+		return (next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+private:
+	unsigned long long state;
+};
+
+// Draws ranks 0..n-1 with probability proportional to 1 / (rank+1)^s
+class Zipf
+{
+public:
+	Zipf(unsigned int n, double s)
+		: cdf(n)
+	{
+		double sum = 0;
+		for (unsigned int i = 0; i < n; ++i)
+			cdf[i] = sum += 1.0 / std::pow(i + 1.0, s);
+		for (unsigned int i = 0; i < n; ++i)
+			cdf[i] /= sum;
+	}
+
+	unsigned int next(Random& random) const
+	{
+		size_t i = std::upper_bound(cdf.begin(), cdf.end(), random.real()) - cdf.begin();
+		return static_cast<unsigned int>(std::min(i, cdf.size() - 1));
+	}
+
+private:
+	std::vector<double> cdf;
+};
+
+struct Corpus
+{
+	const char* name;
+	std::vector<unsigned char> data;
+	// Stages code the data in pieces of this size, to measure per call
+	// overhead on small payloads
+	size_t piece;
+};
+
+void make_uniform(std::vector<unsigned char>& data, Random& random)
+{
+	// 64 equally likely symbols, 6 bits each
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<unsigned char>('0' + (random.next() >> 58));
+}
+
+void make_zipf(std::vector<unsigned char>& data, Random& random)
+{
+	Zipf zipf(256, 1.1);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<unsigned char>(zipf.next(random));
+}
+
+// Low entropy, about 3.5 bits per byte, so most codes are 1 to 4 bits long
+void make_skewed(std::vector<unsigned char>& data, Random& random)
+{
+	Zipf zipf(256, 2.0);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<unsigned char>(zipf.next(random));
+}
+
+void make_text(std::vector<unsigned char>& data, Random& random)
+{
+	static const char* const words[] = {
+		"the", "of", "and", "to", "in", "a", "is", "that", "for", "it",
+		"as", "was", "with", "be", "by", "on", "not", "he", "this", "are",
+		"or", "his", "from", "at", "which", "but", "have", "an", "had", "they",
+		"you", "were", "their", "one", "all", "we", "can", "her", "has", "there",
+		"been", "if", "more", "when", "will", "would", "who", "so", "no", "tree",
+		"code", "length", "symbol", "stream", "block", "frequency", "table", "bit",
+		"compression", "Huffman", "arquivo", "dados", "arvore", "codigo"
+	};
+	static const size_t num_words = sizeof(words) / sizeof(words[0]);
+
+	Zipf zipf(num_words, 1.0);
+	size_t i = 0;
+	unsigned int in_line = 0;
+
+	while (i < data.size())
+	{
+		const char* word = words[zipf.next(random)];
+		for (; *word != 0 && i < data.size(); ++word)
+			data[i++] = static_cast<unsigned char>(*word);
+
+		if (i == data.size())
+			break;
+
+		if (++in_line == 12)
+		{
+			data[i++] = '\n';
+			in_line = 0;
+		}
+		else if (random.next() % 10 == 0)
+		{
+			data[i++] = ',';
+		}
+		else
+		{
+			data[i++] = ' ';
+		}
+	}
+}
+
+void make_random(std::vector<unsigned char>& data, Random& random)
+{
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<unsigned char>(random.next() >> 56);
+}
+
+// Like a disk image: 1 MiB stretches of zeros, random bytes or text
+void make_sparse(std::vector<unsigned char>& data, Random& random)
+{
+	const size_t stretch = 1024 * 1024;
+	for (size_t pos = 0; pos < data.size(); pos += stretch)
+	{
+		std::vector<unsigned char> part(std::min(stretch, data.size() - pos));
+		switch ((pos / stretch) % 3)
+		{
+		case 0: break;
+		case 1: make_random(part, random); break;
+		case 2: make_text(part, random); break;
+		}
+		std::copy(part.begin(), part.end(), data.begin() + pos);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Memory streams for the stream based API
+
+class VectorOutBuf : public std::streambuf
+{
+public:
+	explicit VectorOutBuf(std::vector<char>& out) : out(out) {}
+
+protected:
+	virtual int_type overflow(int_type c)
+	{
+		if (!traits_type::eq_int_type(c, traits_type::eof()))
+			out.push_back(traits_type::to_char_type(c));
+		return traits_type::not_eof(c);
+	}
+
+	virtual std::streamsize xsputn(const char* s, std::streamsize n)
+	{
+		out.insert(out.end(), s, s + n);
+		return n;
+	}
+
+private:
+	std::vector<char>& out;
+};
+
+class MemoryInBuf : public std::streambuf
+{
+public:
+	MemoryInBuf(const char* data, size_t size)
+	{
+		char* p = const_cast<char*>(data);
+		setg(p, p, p + size);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Stages
+
+struct Result
+{
+	std::string corpus;
+	std::string stage;
+	unsigned long long bytes;
+	double seconds;
+	// Compressed size over raw size, or negative if the stage doesn't
+	// compress
+	double ratio;
+	unsigned long long peak_rss_kb;
+};
+
+// Restarts the high-water mark read by peak_rss_kb() from the current RSS,
+// so each stage reports its own peak. Only Linux can do that; elsewhere the
+// peak is the process's so far, and only grows from one stage to the next.
+void reset_peak_rss()
+{
+#if defined(__linux__)
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5";
+#endif
+}
+
+unsigned long long peak_rss_kb()
+{
+#if defined(__linux__)
+	// Unlike ru_maxrss, VmHWM is reset by reset_peak_rss()
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::strtoull(line.c_str() + 6, 0, 10);
+	}
+	return 0;
+#elif defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize / 1024;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#	if defined(__APPLE__)
+	return usage.ru_maxrss / 1024;
+#	else
+	return usage.ru_maxrss;
+#	endif
+#endif
+}
+
+SharedTable corpus_table(const Corpus& corpus)
+{
+	unsigned long long counts[HISTOGRAM_SIZE];
+	histogram(&corpus.data[0], corpus.data.size(), counts);
+	return SharedTable(counts, HUFFMAN_DEFAULT_MAX_CODE_LENGTH);
+}
+
+class Bench
+{
+public:
+	Bench(const Corpus& corpus, double min_time, const std::string& only_stage);
+	~Bench();
+
+	void run(std::vector<Result>& results);
+
+private:
+	typedef void (Bench::*Stage)();
+
+	void measure(const char* name, Stage stage, std::vector<Result>& results);
+	void check(const std::vector<unsigned char>& decoded, const char* stage) const;
+
+	void histogramStage();
+	void parallelHistogramStage();
+	void buildTreeStage();
+	void buildCanonicalStage();
+	void treeCompressStage();
+	void treeUncompressStage();
+	void adaptiveCompressStage();
+	void adaptiveUncompressStage();
+	void blockCompressStage();
+	void blockUncompressStage();
+	void singleUncompressStage();
+	void multiUncompressStage();
+	void contextCompressStage();
+	void contextUncompressStage();
+	void sharedCompressStage();
+	void sharedUncompressStage();
+	void staticCompressStage();
+	void staticUncompressStage();
+	void runtimeCompressStage();
+	void runtimeUncompressStage();
+	void compressPieces(HuffmanContext& context);
+	void uncompressPieces(HuffmanContext& context, const char* stage);
+	void bitWriteStage();
+	void bitReadStage();
+	void kernelEncodeStage();
+	void kernelDecodeStage();
+
+	const Corpus& corpus;
+	double min_time;
+	std::string only_stage;
+	size_t block_piece;
+
+	unsigned long long counts[HISTOGRAM_SIZE];
+	// The whole corpus counted on one thread, and on the pool's threads
+	unsigned long long whole_counts[HISTOGRAM_SIZE];
+	ThreadPool pool;
+	HuffmanTree tree;
+	unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+
+	// Compressed pieces, in order
+	std::vector<std::vector<char> > tree_pieces;
+	std::vector<std::vector<char> > adaptive_pieces;
+	std::vector<unsigned char> blocks;
+	// Blocks decoded one symbol at a time, and with a MultiDecodeTable
+	// whatever their size, to find where building one starts to pay off
+	BlockTables single_tables;
+	BlockTables multi_tables;
+	// Reused by every run, like a long lived caller would
+	HuffmanContext context;
+	// Trained on the whole corpus, the best case for a shared table
+	SharedTable table;
+	HuffmanContext shared_context;
+	std::vector<unsigned char> buffers;
+	std::vector<size_t> buffer_sizes;
+	// The table compiled in from text_table.h, and the same one built at
+	// run time
+	SharedTable text_table;
+	std::vector<unsigned char> fixed_bits;
+	std::vector<size_t> fixed_sizes;
+	std::vector<unsigned char> bits;
+	size_t bits_size;
+	// Block coding loops of one variant, checked against the portable ones
+	const BitKernels* kernels;
+	std::vector<unsigned char> kernel_bits;
+	std::vector<unsigned char> portable_bits;
+	size_t kernel_sizes[BLOCK_DEFAULT_STREAMS];
+
+	std::vector<unsigned char> decoded;
+	unsigned long long compressed_size;
+	unsigned long long checksum;
+};
+
+Bench::Bench(const Corpus& corpus, double min_time, const std::string& only_stage)
+	: corpus(corpus), min_time(min_time), only_stage(only_stage),
+	block_piece(std::min<size_t>(corpus.piece, 1024 * 1024)),
+	table(corpus_table(corpus)), text_table(TextTable::lengths()), bits_size(0), kernels(0), compressed_size(0), checksum(0)
+{
+	register_shared_table(&table);
+	histogram(&corpus.data[0], corpus.data.size(), whole_counts);
+
+	single_tables.multi.bits = 0;
+	multi_tables.multi.min_block_size = 0;
+
+	BlockOptions options;
+	options.streams = 1;
+	options.table_id = table.id();
+	shared_context.setOptions(options);
+}
+
+Bench::~Bench()
+{
+	// The next corpus gets a table of its own, maybe with the same ID
+	unregister_shared_table(&table);
+}
+
+void Bench::run(std::vector<Result>& results)
+{
+	// Decoding stages work on what the stage before them produced
+	measure("histogram", &Bench::histogramStage, results);
+	measure("histogram_parallel", &Bench::parallelHistogramStage, results);
+	measure("build_tree", &Bench::buildTreeStage, results);
+	measure("build_canonical", &Bench::buildCanonicalStage, results);
+	measure("tree_compress", &Bench::treeCompressStage, results);
+	measure("tree_uncompress", &Bench::treeUncompressStage, results);
+	measure("adaptive_compress", &Bench::adaptiveCompressStage, results);
+	measure("adaptive_uncompress", &Bench::adaptiveUncompressStage, results);
+	measure("block_compress", &Bench::blockCompressStage, results);
+	measure("block_uncompress", &Bench::blockUncompressStage, results);
+	measure("single_uncompress", &Bench::singleUncompressStage, results);
+	measure("multi_uncompress", &Bench::multiUncompressStage, results);
+	measure("context_compress", &Bench::contextCompressStage, results);
+	measure("context_uncompress", &Bench::contextUncompressStage, results);
+	measure("shared_compress", &Bench::sharedCompressStage, results);
+	measure("shared_uncompress", &Bench::sharedUncompressStage, results);
+	measure("static_compress", &Bench::staticCompressStage, results);
+	measure("static_uncompress", &Bench::staticUncompressStage, results);
+	measure("runtime_compress", &Bench::runtimeCompressStage, results);
+	measure("runtime_uncompress", &Bench::runtimeUncompressStage, results);
+	measure("bit_write", &Bench::bitWriteStage, results);
+	measure("bit_read", &Bench::bitReadStage, results);
+
+	// Every variant of the block coding loops this CPU can run
+	for (int i = 0; i < NUM_BIT_KERNELS; ++i)
+	{
+		kernels = find_bit_kernels(static_cast<BitKernelsVariant>(i));
+		if (kernels == 0)
+			continue;
+
+		measure(("encode_" + std::string(kernels->name)).c_str(), &Bench::kernelEncodeStage, results);
+		measure(("decode_" + std::string(kernels->name)).c_str(), &Bench::kernelDecodeStage, results);
+	}
+}
+
+void Bench::measure(const char* name, Stage stage, std::vector<Result>& results)
+{
+	// Encoding stages always run once, for the decoders after them
+	const bool wanted = only_stage.empty() || only_stage == name;
+	const bool decoder = std::strstr(name, "uncompress") != 0 || std::strcmp(name, "bit_read") == 0 ||
+		std::strncmp(name, "decode_", 7) == 0;
+	if (!wanted && decoder)
+		return;
+
+	double best = 0;
+	double total = 0;
+	int runs = 0;
+
+	reset_peak_rss();
+
+	// Best of at least three runs
+	do
+	{
+		compressed_size = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		(this->*stage)();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (runs == 0 || seconds < best)
+			best = seconds;
+		total += seconds;
+		++runs;
+	}
+	while (wanted && (runs < 3 || total < min_time));
+
+	if (!wanted)
+		return;
+
+	Result r;
+	r.corpus = corpus.name;
+	r.stage = name;
+	r.bytes = corpus.data.size();
+	r.seconds = best;
+	r.ratio = compressed_size != 0 ? static_cast<double>(compressed_size) / corpus.data.size() : -1;
+	r.peak_rss_kb = peak_rss_kb();
+	results.push_back(r);
+}
+
+void Bench::check(const std::vector<unsigned char>& out, const char* stage) const
+{
+	if (out != corpus.data)
+		throw std::runtime_error(std::string(stage) + " didn't reproduce the " + corpus.name + " corpus");
+}
+
+void Bench::histogramStage()
+{
+	const unsigned char* data = &corpus.data[0];
+
+	for (size_t pos = 0; pos < corpus.data.size(); pos += corpus.piece)
+		histogram(data + pos, std::min(corpus.piece, corpus.data.size() - pos), counts);
+}
+
+void Bench::parallelHistogramStage()
+{
+	histogram_parallel(&corpus.data[0], corpus.data.size(), counts, pool);
+
+	if (!std::equal(counts, counts + HISTOGRAM_SIZE, whole_counts))
+		throw std::runtime_error(std::string("histogram_parallel doesn't match histogram on the ") + corpus.name + " corpus");
+}
+
+void Bench::buildTreeStage()
+{
+	for (size_t pos = 0; pos < corpus.data.size(); pos += corpus.piece)
+	{
+		const unsigned char* begin = &corpus.data[pos];
+		const unsigned char* end = begin + std::min(corpus.piece, corpus.data.size() - pos);
+		build_huffman_tree(begin, end, tree);
+	}
+}
+
+void Bench::buildCanonicalStage()
+{
+	for (size_t pos = 0; pos < corpus.data.size(); pos += corpus.piece)
+	{
+		const unsigned char* begin = &corpus.data[pos];
+		const unsigned char* end = begin + std::min(corpus.piece, corpus.data.size() - pos);
+		build_canonical_code(begin, end, HUFFMAN_DEFAULT_MAX_CODE_LENGTH, lengths);
+	}
+}
+
+void Bench::treeCompressStage()
+{
+	tree_pieces.clear();
+
+	for (size_t pos = 0; pos < corpus.data.size(); pos += corpus.piece)
+	{
+		const size_t size = std::min(corpus.piece, corpus.data.size() - pos);
+		const unsigned char* begin = &corpus.data[pos];
+		const unsigned char* end = begin + size;
+
+		tree_pieces.push_back(std::vector<char>());
+		VectorOutBuf buf(tree_pieces.back());
+		std::ostream out(&buf);
+
+		// The tree is rebuilt for each piece, as the tool does
+		const unsigned char* it = begin;
+		build_huffman_tree(it, end, tree);
+		{
+			OFileBitstream stream(out);
+			it = begin;
+			huffman_compress(tree, stream, it, end, size);
+		}
+
+		compressed_size += tree_pieces.back().size();
+	}
+}
+
+void Bench::treeUncompressStage()
+{
+	std::vector<char> out;
+	out.reserve(corpus.data.size());
+
+	for (size_t i = 0; i < tree_pieces.size(); ++i)
+	{
+		MemoryInBuf in_buf(&tree_pieces[i][0], tree_pieces[i].size());
+		std::istream in(&in_buf);
+		VectorOutBuf out_buf(out);
+		std::ostream out_stream(&out_buf);
+
+		IFileBitstream stream(in);
+		readNode(stream, tree);
+		huffman_uncompress(stream, out_stream, tree, tree_pieces[i].size());
+	}
+
+	decoded.assign(out.begin(), out.end());
+	check(decoded, "tree_uncompress");
+}
+
+// Same pieces as the tree stages, in one pass each
+void Bench::adaptiveCompressStage()
+{
+	adaptive_pieces.clear();
+
+	for (size_t pos = 0; pos < corpus.data.size(); pos += corpus.piece)
+	{
+		const size_t size = std::min(corpus.piece, corpus.data.size() - pos);
+
+		MemoryInBuf in_buf(reinterpret_cast<const char*>(&corpus.data[pos]), size);
+		std::istream in(&in_buf);
+
+		adaptive_pieces.push_back(std::vector<char>());
+		VectorOutBuf buf(adaptive_pieces.back());
+		std::ostream out(&buf);
+
+		{
+			OFileBitstream stream(out);
+			huffman_compress_adaptive(in, stream, ADAPTIVE_DEFAULT_INTERVAL_BITS, ADAPTIVE_DEFAULT_MAX_CODE_LENGTH);
+		}
+
+		compressed_size += adaptive_pieces.back().size();
+	}
+}
+
+void Bench::adaptiveUncompressStage()
+{
+	std::vector<char> out;
+	out.reserve(corpus.data.size());
+
+	for (size_t i = 0; i < adaptive_pieces.size(); ++i)
+	{
+		MemoryInBuf in_buf(&adaptive_pieces[i][0], adaptive_pieces[i].size());
+		std::istream in(&in_buf);
+		VectorOutBuf out_buf(out);
+		std::ostream out_stream(&out_buf);
+
+		IFileBitstream stream(in);
+		huffman_uncompress_adaptive(stream, out_stream);
+	}
+
+	decoded.assign(out.begin(), out.end());
+	check(decoded, "adaptive_uncompress");
+}
+
+void Bench::blockCompressStage()
+{
+	BlockOptions options;
+	blocks.clear();
+
+	for (size_t pos = 0; pos < corpus.data.size(); pos += block_piece)
+		compress_block(&corpus.data[pos], std::min(block_piece, corpus.data.size() - pos), options, blocks);
+
+	compressed_size = blocks.size();
+}
+
+void Bench::blockUncompressStage()
+{
+	decoded.resize(corpus.data.size());
+
+	size_t in_pos = 0;
+	for (size_t pos = 0; pos < corpus.data.size(); pos += block_piece)
+	{
+		BlockHeader header = read_block_header(&blocks[in_pos]);
+		decompress_block(header, &blocks[in_pos + BLOCK_HEADER_SIZE], &decoded[pos]);
+		in_pos += BLOCK_HEADER_SIZE + header.data_size;
+	}
+
+	check(decoded, "block_uncompress");
+}
+
+void Bench::singleUncompressStage()
+{
+	decoded.resize(corpus.data.size());
+
+	size_t in_pos = 0;
+	for (size_t pos = 0; pos < corpus.data.size(); pos += block_piece)
+	{
+		BlockHeader header = read_block_header(&blocks[in_pos]);
+		decompress_block(header, &blocks[in_pos + BLOCK_HEADER_SIZE], &decoded[pos], single_tables);
+		in_pos += BLOCK_HEADER_SIZE + header.data_size;
+	}
+
+	check(decoded, "single_uncompress");
+}
+
+void Bench::multiUncompressStage()
+{
+	decoded.resize(corpus.data.size());
+
+	size_t in_pos = 0;
+	for (size_t pos = 0; pos < corpus.data.size(); pos += block_piece)
+	{
+		BlockHeader header = read_block_header(&blocks[in_pos]);
+		decompress_block(header, &blocks[in_pos + BLOCK_HEADER_SIZE], &decoded[pos], multi_tables);
+		in_pos += BLOCK_HEADER_SIZE + header.data_size;
+	}
+
+	check(decoded, "multi_uncompress");
+}
+
+// Same pieces as the block stages, through one HuffmanContext, so small
+// pieces show the cost of rebuilding the tables from scratch every time.
+void Bench::contextCompressStage()
+{
+	compressPieces(context);
+}
+
+void Bench::contextUncompressStage()
+{
+	uncompressPieces(context, "context_uncompress");
+}
+
+// Skips the histogram, the code and its header in every piece
+void Bench::sharedCompressStage()
+{
+	compressPieces(shared_context);
+}
+
+void Bench::sharedUncompressStage()
+{
+	uncompressPieces(shared_context, "shared_uncompress");
+}
+
+// Bare codes of each piece, with the text table known at compile time
+void Bench::staticCompressStage()
+{
+	size_t bound = static_compress_bound<TextTable>(corpus.piece);
+	size_t pieces = (corpus.data.size() + corpus.piece - 1) / corpus.piece;
+	fixed_bits.resize(pieces * bound);
+	fixed_sizes.resize(pieces);
+
+	compressed_size = 0;
+	for (size_t i = 0; i < pieces; ++i)
+	{
+		size_t pos = i * corpus.piece;
+		fixed_sizes[i] = static_compress<TextTable>(&corpus.data[pos], std::min(corpus.piece, corpus.data.size() - pos),
+			&fixed_bits[i * bound]);
+		compressed_size += fixed_sizes[i];
+	}
+}
+
+void Bench::staticUncompressStage()
+{
+	decoded.resize(corpus.data.size());
+
+	size_t bound = static_compress_bound<TextTable>(corpus.piece);
+	for (size_t i = 0; i < fixed_sizes.size(); ++i)
+	{
+		size_t pos = i * corpus.piece;
+		static_uncompress<TextTable>(&fixed_bits[i * bound], fixed_sizes[i], &decoded[pos],
+			std::min(corpus.piece, corpus.data.size() - pos));
+	}
+
+	check(decoded, "static_uncompress");
+}
+
+// Same codes, with the tables built at run time
+void Bench::runtimeCompressStage()
+{
+	const EncodeTable& encode_table = text_table.encodeTable();
+	size_t bound = static_compress_bound<TextTable>(corpus.piece);
+
+	compressed_size = 0;
+	for (size_t i = 0; i < fixed_sizes.size(); ++i)
+	{
+		size_t pos = i * corpus.piece;
+		size_t end = std::min(pos + corpus.piece, corpus.data.size());
+
+		OMemoryBitstream stream(&fixed_bits[i * bound]);
+		for (; pos < end; ++pos)
+			encode_table.encode(stream, corpus.data[pos]);
+
+		fixed_sizes[i] = stream.finish();
+		compressed_size += fixed_sizes[i];
+	}
+}
+
+void Bench::runtimeUncompressStage()
+{
+	const DecodeTable& decode_table = text_table.decodeTable();
+	decoded.resize(corpus.data.size());
+
+	size_t bound = static_compress_bound<TextTable>(corpus.piece);
+	for (size_t i = 0; i < fixed_sizes.size(); ++i)
+	{
+		size_t pos = i * corpus.piece;
+		size_t end = std::min(pos + corpus.piece, corpus.data.size());
+
+		IMemoryBitstream stream(&fixed_bits[i * bound], fixed_sizes[i]);
+		for (; pos < end; ++pos)
+			decoded[pos] = static_cast<unsigned char>(decode_table.decode(stream));
+	}
+
+	check(decoded, "runtime_uncompress");
+}
+
+void Bench::compressPieces(HuffmanContext& context)
+{
+	size_t bound = huffman_compress_bound(block_piece);
+	size_t pieces = (corpus.data.size() + block_piece - 1) / block_piece;
+	buffers.resize(pieces * bound);
+	buffer_sizes.resize(pieces);
+
+	compressed_size = 0;
+	for (size_t i = 0; i < pieces; ++i)
+	{
+		size_t pos = i * block_piece;
+		buffer_sizes[i] = context.compress(&corpus.data[pos], std::min(block_piece, corpus.data.size() - pos),
+			&buffers[i * bound], bound);
+		compressed_size += buffer_sizes[i];
+	}
+}
+
+void Bench::uncompressPieces(HuffmanContext& context, const char* stage)
+{
+	decoded.resize(corpus.data.size());
+
+	size_t bound = huffman_compress_bound(block_piece);
+	for (size_t i = 0; i < buffer_sizes.size(); ++i)
+	{
+		size_t pos = i * block_piece;
+		context.decompress(&buffers[i * bound], buffer_sizes[i], &decoded[pos], decoded.size() - pos);
+	}
+
+	check(decoded, stage);
+}
+
+// Fields of 1 to 16 bits, cycling through the lengths
+void Bench::bitWriteStage()
+{
+	bits.resize(corpus.data.size() * 2 + 8);
+	OMemoryBitstream stream(&bits[0]);
+
+	for (size_t i = 0; i < corpus.data.size(); ++i)
+	{
+		int length = static_cast<int>(i & 15) + 1;
+		stream.pushBits(corpus.data[i] * 257u, length);
+	}
+
+	bits_size = stream.finish();
+}
+
+void Bench::bitReadStage()
+{
+	IMemoryBitstream stream(&bits[0], bits_size);
+	unsigned long long sum = 0;
+
+	for (size_t i = 0; i < corpus.data.size(); ++i)
+	{
+		int length = static_cast<int>(i & 15) + 1;
+		unsigned int field = stream.peekBits(length);
+		stream.skipBits(length);
+
+		if (field != ((corpus.data[i] * 257u) & ((1u << length) - 1)))
+			throw std::runtime_error(std::string("bit_read didn't reproduce the ") + corpus.name + " corpus");
+		sum += field;
+	}
+
+	checksum = sum;
+}
+
+// The corpus as one block's worth of interleaved streams, with the table
+// trained on it
+void Bench::kernelEncodeStage()
+{
+	kernel_bits.resize(compressed_block_bound(corpus.data.size()));
+	size_t size = kernels->encode(table.encodeTable(), &corpus.data[0], corpus.data.size(),
+		BLOCK_DEFAULT_STREAMS, &kernel_bits[0], kernel_sizes);
+	kernel_bits.resize(size);
+	compressed_size = size;
+
+	if (kernels == find_bit_kernels(BIT_KERNELS_PORTABLE))
+		portable_bits = kernel_bits;
+	else if (!portable_bits.empty() && kernel_bits != portable_bits)
+		throw std::runtime_error(std::string("encode_") + kernels->name + " doesn't match the portable output");
+}
+
+void Bench::kernelDecodeStage()
+{
+	const unsigned char* data[BLOCK_DEFAULT_STREAMS];
+	size_t pos = 0;
+	for (int j = 0; j < BLOCK_DEFAULT_STREAMS; ++j)
+	{
+		data[j] = &kernel_bits[pos];
+		pos += kernel_sizes[j];
+	}
+
+	decoded.resize(corpus.data.size());
+	kernels->decode(table.decodeTable(), data, kernel_sizes, BLOCK_DEFAULT_STREAMS, decoded.size(), &decoded[0]);
+	check(decoded, "decode_kernel");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Large inputs
+
+// Made-up input of any size, so sizes past 4 GiB can be checked without
+// the disk space for them. It looks like a sparse file: most 1 MiB
+// stretches are one byte repeated, a different one for each, and every
+// 16th is zeros with its offset written at the start of each 4 KiB, so
+// data put in the wrong place doesn't go unnoticed.
+void make_large(unsigned long long pos, unsigned char* out, size_t size)
+{
+	while (size > 0)
+	{
+		const unsigned long long page = pos & ~4095ULL;
+		const size_t skip = static_cast<size_t>(pos - page);
+		const size_t n = std::min<size_t>(4096 - skip, size);
+		const unsigned long long stretch = pos >> 20;
+
+		if (stretch % 16 != 0)
+		{
+			std::memset(out, static_cast<int>((stretch * 0x9E3779B97F4A7C15ULL) >> 56), n);
+		}
+		else
+		{
+			std::memset(out, 0, n);
+			for (size_t i = skip; i < 8 && i < skip + n; ++i)
+				out[i - skip] = static_cast<unsigned char>(page >> (8 * i));
+		}
+
+		pos += n;
+		out += n;
+		size -= n;
+	}
+}
+
+// make_large's bytes, made as they are read. Seekable, for the formats
+// that read their input twice.
+class LargeInBuf : public std::streambuf
+{
+public:
+	explicit LargeInBuf(unsigned long long size) : size(size), next(0), buffer(64 * 1024) {}
+
+protected:
+	virtual int_type underflow()
+	{
+		if (next >= size)
+			return traits_type::eof();
+
+		size_t n = static_cast<size_t>(std::min<unsigned long long>(buffer.size(), size - next));
+		make_large(next, reinterpret_cast<unsigned char*>(&buffer[0]), n);
+		setg(&buffer[0], &buffer[0], &buffer[0] + n);
+		next += n;
+
+		return traits_type::to_int_type(buffer[0]);
+	}
+
+	// Like a file, everything left can be read without waiting
+	virtual std::streamsize showmanyc()
+	{
+		return static_cast<std::streamsize>(std::min<unsigned long long>(size - next, 1ULL << 30));
+	}
+
+	virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode)
+	{
+		unsigned long long pos = next - (egptr() - gptr());
+		if (dir == std::ios_base::beg)
+			pos = off;
+		else if (dir == std::ios_base::cur)
+			pos += off;
+		else
+			pos = size + off;
+
+		if (pos > size)
+			return pos_type(off_type(-1));
+
+		next = pos;
+		setg(0, 0, 0);
+		return pos_type(off_type(pos));
+	}
+
+	virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+
+private:
+	unsigned long long size;
+	unsigned long long next;
+	std::vector<char> buffer;
+};
+
+// Compares what is written to it with make_large's bytes, without keeping
+// any of it. Must be flushed before asking how it went.
+class LargeCheckBuf : public std::streambuf
+{
+public:
+	LargeCheckBuf() : pos(0), mismatch(~0ULL), buffer(64 * 1024), expected(64 * 1024)
+	{
+		setp(&buffer[0], &buffer[0] + buffer.size());
+	}
+
+	unsigned long long size() const { return pos; }
+	// Offset of the first wrong byte, ~0ULL if there is none
+	unsigned long long firstMismatch() const { return mismatch; }
+
+protected:
+	virtual int_type overflow(int_type c)
+	{
+		check();
+		if (!traits_type::eq_int_type(c, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	virtual int sync()
+	{
+		check();
+		return 0;
+	}
+
+private:
+	void check()
+	{
+		size_t n = pptr() - pbase();
+		make_large(pos, &expected[0], n);
+
+		if (mismatch == ~0ULL && std::memcmp(pbase(), &expected[0], n) != 0)
+		{
+			size_t i = 0;
+			while (static_cast<unsigned char>(pbase()[i]) == expected[i])
+				++i;
+			mismatch = pos + i;
+		}
+
+		pos += n;
+		setp(&buffer[0], &buffer[0] + buffer.size());
+	}
+
+	unsigned long long pos;
+	unsigned long long mismatch;
+	std::vector<char> buffer;
+	std::vector<unsigned char> expected;
+};
+
+// Pipe between a writer and a reader thread in the same process, holding
+// at most a few chunks, so formats that code a whole input as one stream
+// can be checked with memory that doesn't grow with it.
+class PipeBuf : public std::streambuf
+{
+public:
+	PipeBuf() : closed(false), passed(0), out_chunk(256 * 1024)
+	{
+		setp(&out_chunk[0], &out_chunk[0] + out_chunk.size());
+	}
+
+	// Ends the stream. The reader sees the end once it has read what came
+	// before, and the writer's data is dropped from then on, so either
+	// side can give up without leaving the other one waiting.
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		cond.notify_all();
+	}
+
+	// Bytes written through the pipe
+	unsigned long long size() const { return passed; }
+
+protected:
+	virtual int_type overflow(int_type c)
+	{
+		push();
+		if (!traits_type::eq_int_type(c, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	virtual int sync()
+	{
+		push();
+		return 0;
+	}
+
+	virtual int_type underflow()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (chunks.empty() && !closed)
+			cond.wait(lock);
+		if (chunks.empty())
+			return traits_type::eof();
+
+		in_chunk.swap(chunks.front());
+		chunks.pop_front();
+		cond.notify_all();
+
+		setg(&in_chunk[0], &in_chunk[0], &in_chunk[0] + in_chunk.size());
+		return traits_type::to_int_type(in_chunk[0]);
+	}
+
+private:
+	void push()
+	{
+		size_t n = pptr() - pbase();
+		if (n == 0)
+			return;
+
+		std::unique_lock<std::mutex> lock(mutex);
+		while (chunks.size() >= 4 && !closed)
+			cond.wait(lock);
+
+		if (!closed)
+		{
+			chunks.push_back(std::vector<char>(pbase(), pbase() + n));
+			passed += n;
+			cond.notify_all();
+		}
+
+		setp(&out_chunk[0], &out_chunk[0] + out_chunk.size());
+	}
+
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::deque<std::vector<char> > chunks;
+	bool closed;
+	unsigned long long passed;
+	std::vector<char> out_chunk;
+	std::vector<char> in_chunk;
+};
+
+void check_large(const LargeCheckBuf& check, unsigned long long size, const char* format)
+{
+	std::ostringstream s;
+	if (check.firstMismatch() != ~0ULL)
+		s << format << " got byte " << check.firstMismatch() << " wrong";
+	else if (check.size() != size)
+		s << format << " decoded " << check.size() << " bytes instead of " << size;
+	else
+		return;
+
+	throw std::runtime_error(s.str());
+}
+
+// Blocks go through memory, where they take about 1% of the input, and are
+// read back both in one pass and through the index, for the last few
+// blocks, which start past 4 GiB on inputs that big
+unsigned long long large_blocks(unsigned long long size)
+{
+	std::vector<char> compressed;
+	{
+		LargeInBuf in_buf(size);
+		std::istream in(&in_buf);
+		VectorOutBuf out_buf(compressed);
+		std::ostream out(&out_buf);
+
+		ContainerOptions options;
+		compress_blocks(in, out, options);
+	}
+
+	{
+		MemoryInBuf in_buf(&compressed[0], compressed.size());
+		std::istream in(&in_buf);
+		LargeCheckBuf check;
+		std::ostream out(&check);
+
+		if (read_format(in) != FORMAT_BLOCKS)
+			throw std::runtime_error("blocks didn't write their format");
+		decompress_blocks(in, out, 0);
+		out.flush();
+		check_large(check, size, "blocks");
+	}
+
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(&compressed[0]);
+	ContainerIndex index = read_container_index(data, compressed.size());
+	if (index.raw_size != size)
+		throw std::runtime_error("the block index has the wrong size");
+
+	const unsigned long long offset = size - std::min<unsigned long long>(size, 3 * 1024 * 1024 + 123);
+	std::vector<unsigned char> range(static_cast<size_t>(size - offset));
+	std::vector<unsigned char> expected(range.size());
+	decompress_range(data, index, offset, range.size(), range.empty() ? 0 : &range[0], 0);
+	make_large(offset, expected.empty() ? 0 : &expected[0], expected.size());
+	if (range != expected)
+		throw std::runtime_error("blocks decoded through the index don't match");
+
+	return compressed.size();
+}
+
+// The single stream formats are coded on another thread and decoded as
+// they come through a PipeBuf
+unsigned long long large_stream(unsigned long long size, HuffmanFormat format)
+{
+	PipeBuf pipe;
+	std::exception_ptr failed;
+
+	std::thread writer([&]()
+	{
+		try
+		{
+			LargeInBuf in_buf(size);
+			std::istream in(&in_buf);
+			std::ostream out(&pipe);
+			{
+				OFileBitstream stream(out);
+				std::istreambuf_iterator<char> in_iter(in);
+
+				if (format == FORMAT_CANONICAL)
+				{
+					unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+					build_canonical_code(in_iter, std::istreambuf_iterator<char>(), HUFFMAN_DEFAULT_MAX_CODE_LENGTH, lengths);
+					in.seekg(0);
+					huffman_compress_canonical(lengths, stream, in_iter, std::istreambuf_iterator<char>(), size);
+				}
+				else if (format == FORMAT_TREE)
+				{
+					HuffmanTree tree;
+					build_huffman_tree(in_iter, std::istreambuf_iterator<char>(), tree);
+					in.seekg(0);
+					huffman_compress(tree, stream, in_iter, std::istreambuf_iterator<char>(), size);
+				}
+				else
+				{
+					write_format(stream, FORMAT_ADAPTIVE);
+					huffman_compress_adaptive(in, stream, ADAPTIVE_DEFAULT_INTERVAL_BITS, ADAPTIVE_DEFAULT_MAX_CODE_LENGTH);
+				}
+			}
+			out.flush();
+		}
+		catch (...)
+		{
+			failed = std::current_exception();
+		}
+		pipe.close();
+	});
+
+	try
+	{
+		std::istream in(&pipe);
+		LargeCheckBuf check;
+		std::ostream out(&check);
+
+		if (read_format(in) != format)
+			throw std::runtime_error("wrong format");
+
+		IFileBitstream stream(in);
+		if (format == FORMAT_CANONICAL)
+		{
+			huffman_uncompress_canonical(stream, out, 0);
+		}
+		else if (format == FORMAT_TREE)
+		{
+			HuffmanTree tree;
+			readNode(stream, tree);
+			huffman_uncompress(stream, out, tree, 0);
+		}
+		else
+		{
+			huffman_uncompress_adaptive(stream, out);
+		}
+
+		out.flush();
+		pipe.close();
+		writer.join();
+		if (failed)
+			std::rethrow_exception(failed);
+
+		check_large(check, size, format == FORMAT_CANONICAL ? "canonical" : format == FORMAT_TREE ? "tree" : "adaptive");
+	}
+	catch (...)
+	{
+		pipe.close();
+		if (writer.joinable())
+			writer.join();
+		throw;
+	}
+
+	return pipe.size();
+}
+
+// Round trips size bytes of make_large through every format, timing each
+void run_large(unsigned long long size, const std::string& only_stage, std::vector<Result>& results)
+{
+	static const char* const names[] = { "blocks", "canonical", "tree", "adaptive" };
+	static const HuffmanFormat formats[] = { FORMAT_BLOCKS, FORMAT_CANONICAL, FORMAT_TREE, FORMAT_ADAPTIVE };
+
+	for (int i = 0; i < 4; ++i)
+	{
+		if (!only_stage.empty() && only_stage != names[i])
+			continue;
+
+		reset_peak_rss();
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		unsigned long long compressed = formats[i] == FORMAT_BLOCKS ? large_blocks(size) : large_stream(size, formats[i]);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		Result r;
+		r.corpus = "large";
+		r.stage = names[i];
+		r.bytes = size;
+		r.seconds = seconds;
+		r.ratio = static_cast<double>(compressed) / size;
+		r.peak_rss_kb = peak_rss_kb();
+		results.push_back(r);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Output
+
+void print_table(const std::vector<Result>& results)
+{
+	std::cout << std::left << std::setw(10) << "corpus" << std::setw(18) << "stage"
+		<< std::right << std::setw(12) << "MB/s" << std::setw(12) << "ns/symbol"
+		<< std::setw(10) << "ratio" << std::setw(14) << "peak RSS KB" << '\n';
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& r = results[i];
+
+		std::cout << std::left << std::setw(10) << r.corpus << std::setw(18) << r.stage << std::right
+			<< std::fixed << std::setprecision(1) << std::setw(12) << r.bytes / r.seconds / 1e6
+			<< std::setprecision(3) << std::setw(12) << r.seconds * 1e9 / r.bytes
+			<< std::setw(10);
+		if (r.ratio >= 0)
+			std::cout << std::setprecision(4) << r.ratio;
+		else
+			std::cout << "-";
+		std::cout << std::setw(14) << r.peak_rss_kb << '\n';
+	}
+}
+
+void print_json(const std::vector<Result>& results, unsigned long long size, double min_time)
+{
+	std::ostringstream s;
+	s << std::setprecision(9);
+
+	s << "{\n  \"benchmark\": \"huffman\",\n  \"format\": 1,\n";
+	s << "  \"size\": " << size << ",\n  \"min_time\": " << min_time << ",\n";
+	s << "  \"results\": [\n";
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& r = results[i];
+
+		s << "    {\"corpus\": \"" << r.corpus << "\", \"stage\": \"" << r.stage << "\""
+			<< ", \"bytes\": " << r.bytes
+			<< ", \"seconds\": " << r.seconds
+			<< ", \"mb_per_s\": " << r.bytes / r.seconds / 1e6
+			<< ", \"ns_per_symbol\": " << r.seconds * 1e9 / r.bytes
+			<< ", \"ratio\": ";
+		if (r.ratio >= 0)
+			s << r.ratio;
+		else
+			s << "null";
+		s << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}"
+			<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+
+	s << "  ]\n}\n";
+	std::cout << s.str();
+}
+
+// Parses a byte count with an optional K or M suffix
+unsigned long long parse_size(const char* s)
+{
+	char* suffix;
+	unsigned long long size = std::strtoull(s, &suffix, 10);
+
+	if (*suffix == 'K' || *suffix == 'k')
+		size <<= 10;
+	else if (*suffix == 'M' || *suffix == 'm')
+		size <<= 20;
+	else if (*suffix == 'G' || *suffix == 'g')
+		size <<= 30;
+
+	return size;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	unsigned long long size = 8 * 1024 * 1024;
+	double min_time = 0.5;
+	std::string only_corpus;
+	std::string only_stage;
+	unsigned long long piece = 0;
+	unsigned long long large = 0;
+	bool json = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string opt(argv[i]);
+
+		if (opt.compare(0, 7, "--size=") == 0)
+			size = parse_size(opt.c_str() + 7);
+		else if (opt.compare(0, 11, "--min-time=") == 0)
+			min_time = std::atof(opt.c_str() + 11);
+		else if (opt.compare(0, 9, "--corpus=") == 0)
+			only_corpus = opt.substr(9);
+		else if (opt.compare(0, 8, "--piece=") == 0)
+			piece = parse_size(opt.c_str() + 8);
+		else if (opt.compare(0, 8, "--stage=") == 0)
+			only_stage = opt.substr(8);
+		else if (opt.compare(0, 8, "--large=") == 0)
+			large = parse_size(opt.c_str() + 8);
+		else if (opt == "--json")
+			json = true;
+		else
+		{
+			std::cerr << "Usage: huffman_bench [--size=N[K|M]] [--min-time=SECONDS] [--corpus=NAME] [--piece=N[K|M]] [--stage=NAME] [--json]" << std::endl;
+			std::cerr << "       huffman_bench --large=N[K|M|G] [--stage=FORMAT] [--json]" << std::endl;
+			std::cerr << "Corpora: uniform zipf skewed text random sparse tiny" << std::endl;
+			std::cerr << "Stages: histogram histogram_parallel build_tree build_canonical" << std::endl;
+			std::cerr << "        tree_compress tree_uncompress adaptive_compress adaptive_uncompress" << std::endl;
+			std::cerr << "        block_compress block_uncompress single_uncompress multi_uncompress" << std::endl;
+			std::cerr << "        context_compress context_uncompress" << std::endl;
+			std::cerr << "        shared_compress shared_uncompress bit_write bit_read" << std::endl;
+			std::cerr << "        static_compress static_uncompress runtime_compress runtime_uncompress" << std::endl;
+			std::cerr << "        encode_portable decode_portable encode_bmi2 decode_bmi2" << std::endl;
+			std::cerr << "Formats for --large: blocks canonical tree adaptive" << std::endl;
+			return 1;
+		}
+	}
+
+	if (large != 0)
+	{
+		std::vector<Result> results;
+
+		try
+		{
+			run_large(large, only_stage, results);
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << "Large input check failed: " << e.what() << std::endl;
+			return 2;
+		}
+
+		if (json)
+			print_json(results, large, 0);
+		else
+			print_table(results);
+
+		return 0;
+	}
+
+	if (size == 0 || size > (1ULL << 31))
+	{
+		std::cerr << "Invalid size: " << size << std::endl;
+		return 1;
+	}
+
+	typedef void (*Generator)(std::vector<unsigned char>&, Random&);
+	struct CorpusSpec
+	{
+		const char* name;
+		Generator generate;
+		size_t piece;
+	};
+	static const CorpusSpec specs[] = {
+		{ "uniform", make_uniform, 0 },
+		{ "zipf", make_zipf, 0 },
+		{ "skewed", make_skewed, 0 },
+		{ "text", make_text, 0 },
+		{ "random", make_random, 0 },
+		{ "sparse", make_sparse, 0 },
+		// Many small messages, coded one at a time
+		{ "tiny", make_text, 64 }
+	};
+
+	std::vector<Result> results;
+
+	try
+	{
+		for (size_t i = 0; i < sizeof(specs) / sizeof(specs[0]); ++i)
+		{
+			if (!only_corpus.empty() && only_corpus != specs[i].name)
+				continue;
+
+			Corpus corpus;
+			corpus.name = specs[i].name;
+			corpus.data.resize(static_cast<size_t>(size));
+			corpus.piece = specs[i].piece != 0 ? specs[i].piece : corpus.data.size();
+			if (piece != 0)
+				corpus.piece = static_cast<size_t>(std::min(piece, size));
+
+			// Same seed for every corpus and every run
+			Random random(0x9E3779B97F4A7C15ULL);
+			specs[i].generate(corpus.data, random);
+
+			Bench bench(corpus, min_time, only_stage);
+			bench.run(results);
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << "Benchmark failed: " << e.what() << std::endl;
+		return 2;
+	}
+
+	if (json)
+		print_json(results, size, min_time);
+	else
+		print_table(results);
+
+	return 0;
+}
@@ -0,0 +1,312 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "bit_kernels.h"
+#include "bitstream.h"
+#include "block.h"
+
+// Each variant has to get its own copy of the whole loop, bit I/O and table
+// lookups included, so everything is inlined into it.
+#if defined(__GNUC__)
+#	define KERNEL __attribute__((flatten))
+#else
+#	define KERNEL
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	include <cpuid.h>
+#	define HAVE_BMI2_KERNELS 1
+#	define KERNEL_BMI2 __attribute__((flatten, target("bmi,bmi2,lzcnt")))
+#else
+#	define HAVE_BMI2_KERNELS 0
+#endif
+
+namespace
+{
+
+template <typename Reader>
+inline unsigned int decode4(const DecodeTable& table, Reader* s, unsigned char* out)
+{
+	// No dependency between the streams, so the lookups can overlap
+	unsigned int a = table.decode(s[0]);
+	unsigned int b = table.decode(s[1]);
+	unsigned int c = table.decode(s[2]);
+	unsigned int d = table.decode(s[3]);
+
+	out[0] = static_cast<unsigned char>(a);
+	out[1] = static_cast<unsigned char>(b);
+	out[2] = static_cast<unsigned char>(c);
+	out[3] = static_cast<unsigned char>(d);
+
+	return a | b | c | d;
+}
+
+inline size_t encode_streams(const EncodeTable& table, const unsigned char* data, size_t size,
+	unsigned int streams, unsigned char* out, size_t* stream_sizes)
+{
+	// Each stream is done before the next
+	size_t pos = 0;
+	for (unsigned int j = 0; j < streams; ++j)
+	{
+		OMemoryBitstream stream(out + pos);
+		for (size_t i = j; i < size; i += streams)
+			table.encode(stream, data[i]);
+
+		stream_sizes[j] = stream.finish();
+		pos += stream_sizes[j];
+	}
+
+	return pos;
+}
+
+inline unsigned int decode_streams(const DecodeTable& table, const unsigned char* const* data, const size_t* sizes,
+	unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	unsigned int symbols = 0;
+
+	if (streams == 1)
+	{
+		IMemoryBitstream stream(data[0], sizes[0]);
+
+		for (size_t i = 0; i < raw_size; ++i)
+		{
+			unsigned int val = table.decode(stream);
+			symbols |= val;
+			out[i] = static_cast<unsigned char>(val);
+		}
+
+		return symbols;
+	}
+
+	IMemoryBitstream readers[BLOCK_MAX_STREAMS];
+	for (unsigned int j = 0; j < streams; ++j)
+		readers[j] = IMemoryBitstream(data[j], sizes[j]);
+
+	size_t i = 0;
+
+	if (streams == 4)
+	{
+		for (; i + 4 <= raw_size; i += 4)
+			symbols |= decode4(table, readers, out + i);
+	}
+
+	for (; i < raw_size; ++i)
+	{
+		unsigned int val = table.decode(readers[i % streams]);
+		symbols |= val;
+		out[i] = static_cast<unsigned char>(val);
+	}
+
+	return symbols;
+}
+
+// One lookup in each of the streams, with the stores grouped at the end so
+// they don't get in the way of the lookups. Returns whether every stream
+// still has room for a whole entry.
+template <unsigned int Streams>
+inline bool decode_multi_round(const MultiDecodeTable& multi, const DecodeTable& table, IMemoryBitstream* s,
+	size_t* done, const size_t* total, unsigned char* out, unsigned int& symbols)
+{
+	const unsigned int max_symbols = MultiDecodeTable::max_symbols;
+	unsigned char decoded[Streams][max_symbols];
+	unsigned int count[Streams];
+
+	for (unsigned int j = 0; j < Streams; ++j)
+		symbols |= multi.decode(s[j], table, decoded[j], count[j]);
+
+	bool room = true;
+	for (unsigned int j = 0; j < Streams; ++j)
+	{
+		unsigned char* p = out + j + done[j] * Streams;
+		for (unsigned int k = 0; k < max_symbols; ++k)
+			p[k * Streams] = decoded[j][k];
+
+		done[j] += count[j];
+		room &= total[j] - done[j] >= max_symbols;
+	}
+
+	return room;
+}
+
+template <unsigned int Streams>
+inline void decode_multi_rounds(const MultiDecodeTable& multi, const DecodeTable& table, IMemoryBitstream* s,
+	size_t* done, const size_t* total, unsigned char* out, unsigned int& symbols)
+{
+	while (decode_multi_round<Streams>(multi, table, s, done, total, out, symbols))
+		;
+}
+
+// Each stream yields a varying number of symbols per lookup, so every stream
+// keeps its own position. They go in lockstep while all of them have room
+// for a whole entry, then the rest is decoded one symbol at a time.
+inline unsigned int decode_multi_streams(const MultiDecodeTable& multi, const DecodeTable& table,
+	const unsigned char* const* data, const size_t* sizes, unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	const unsigned int max_symbols = MultiDecodeTable::max_symbols;
+	unsigned int symbols = 0;
+
+	if (streams == 1)
+	{
+		IMemoryBitstream stream(data[0], sizes[0]);
+
+		size_t i = 0;
+		unsigned int count;
+		for (; i + max_symbols <= raw_size; i += count)
+			symbols |= multi.decode(stream, table, out + i, count);
+
+		for (; i < raw_size; ++i)
+		{
+			unsigned int val = table.decode(stream);
+			symbols |= val;
+			out[i] = static_cast<unsigned char>(val);
+		}
+
+		return symbols;
+	}
+
+	IMemoryBitstream readers[BLOCK_MAX_STREAMS];
+	size_t done[BLOCK_MAX_STREAMS];
+	size_t total[BLOCK_MAX_STREAMS];
+	bool room = true;
+
+	for (unsigned int j = 0; j < streams; ++j)
+	{
+		readers[j] = IMemoryBitstream(data[j], sizes[j]);
+		done[j] = 0;
+		total[j] = (raw_size + streams - 1 - j) / streams;
+		room &= total[j] >= max_symbols;
+	}
+
+	// The stride has to be known to keep the positions in registers
+	if (room)
+	{
+		switch (streams)
+		{
+		case 2: decode_multi_rounds<2>(multi, table, readers, done, total, out, symbols); break;
+		case 3: decode_multi_rounds<3>(multi, table, readers, done, total, out, symbols); break;
+		case 4: decode_multi_rounds<4>(multi, table, readers, done, total, out, symbols); break;
+		case 5: decode_multi_rounds<5>(multi, table, readers, done, total, out, symbols); break;
+		case 6: decode_multi_rounds<6>(multi, table, readers, done, total, out, symbols); break;
+		case 7: decode_multi_rounds<7>(multi, table, readers, done, total, out, symbols); break;
+		case 8: decode_multi_rounds<8>(multi, table, readers, done, total, out, symbols); break;
+		}
+	}
+
+	for (unsigned int j = 0; j < streams; ++j)
+	{
+		for (size_t i = j + done[j] * streams; i < raw_size; i += streams)
+		{
+			unsigned int val = table.decode(readers[j]);
+			symbols |= val;
+			out[i] = static_cast<unsigned char>(val);
+		}
+	}
+
+	return symbols;
+}
+
+KERNEL size_t encode_portable(const EncodeTable& table, const unsigned char* data, size_t size,
+	unsigned int streams, unsigned char* out, size_t* stream_sizes)
+{
+	return encode_streams(table, data, size, streams, out, stream_sizes);
+}
+
+KERNEL unsigned int decode_portable(const DecodeTable& table, const unsigned char* const* data, const size_t* sizes,
+	unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	return decode_streams(table, data, sizes, streams, raw_size, out);
+}
+
+KERNEL unsigned int decode_multi_portable(const MultiDecodeTable& multi, const DecodeTable& table,
+	const unsigned char* const* data, const size_t* sizes, unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	return decode_multi_streams(multi, table, data, sizes, streams, raw_size, out);
+}
+
+#if HAVE_BMI2_KERNELS
+
+KERNEL_BMI2 size_t encode_bmi2(const EncodeTable& table, const unsigned char* data, size_t size,
+	unsigned int streams, unsigned char* out, size_t* stream_sizes)
+{
+	return encode_streams(table, data, size, streams, out, stream_sizes);
+}
+
+KERNEL_BMI2 unsigned int decode_bmi2(const DecodeTable& table, const unsigned char* const* data, const size_t* sizes,
+	unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	return decode_streams(table, data, sizes, streams, raw_size, out);
+}
+
+KERNEL_BMI2 unsigned int decode_multi_bmi2(const MultiDecodeTable& multi, const DecodeTable& table,
+	const unsigned char* const* data, const size_t* sizes, unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	return decode_multi_streams(multi, table, data, sizes, streams, raw_size, out);
+}
+
+bool cpu_has_bmi2()
+{
+	unsigned int a, b, c, d;
+
+	// BMI1 and BMI2
+	if (!__get_cpuid_count(7, 0, &a, &b, &c, &d) || (b & (1 << 3)) == 0 || (b & (1 << 8)) == 0)
+		return false;
+	// LZCNT
+	if (!__get_cpuid(0x80000001, &a, &b, &c, &d) || (c & (1 << 5)) == 0)
+		return false;
+
+	return true;
+}
+
+#endif
+
+const BitKernels kernels[NUM_BIT_KERNELS] = {
+	{ "portable", encode_portable, decode_portable, decode_multi_portable },
+#if HAVE_BMI2_KERNELS
+	{ "bmi2", encode_bmi2, decode_bmi2, decode_multi_bmi2 }
+#else
+	{ "bmi2", 0, 0, 0 }
+#endif
+};
+
+} // namespace
+
+const BitKernels* find_bit_kernels(BitKernelsVariant variant)
+{
+	if (variant == BIT_KERNELS_PORTABLE)
+		return &kernels[BIT_KERNELS_PORTABLE];
+
+#if HAVE_BMI2_KERNELS
+	static const bool has_bmi2 = cpu_has_bmi2();
+	if (variant == BIT_KERNELS_BMI2 && has_bmi2)
+		return &kernels[BIT_KERNELS_BMI2];
+#endif
+
+	return 0;
+}
+
+const BitKernels& bit_kernels()
+{
+	static const BitKernels* best = find_bit_kernels(BIT_KERNELS_BMI2) != 0 ?
+		find_bit_kernels(BIT_KERNELS_BMI2) : find_bit_kernels(BIT_KERNELS_PORTABLE);
+	return *best;
+}
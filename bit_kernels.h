@@ -0,0 +1,72 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_BIT_KERNELS_H
+#define YURIKS_BIT_KERNELS_H
+
+#include "decode_table.h"
+#include "encode_table.h"
+#include "multi_decode_table.h"
+
+#include <cstddef>
+
+// The loops that code a block's symbols, bit I/O included. They're compiled
+// once for any CPU and, with GCC or Clang on x86, once more for CPUs with
+// BMI2, where the variable shifts and masks of the bit reader and writer
+// become shrx/shlx and bzhi. The CPU is checked once, on first use. Every
+// variant produces the same output.
+struct BitKernels
+{
+	const char* name;
+
+	// Codes data as `streams` streams, symbol i going to stream i % streams,
+	// written back to back from out. Fills in the size of each stream and
+	// returns the total.
+	size_t (*encode)(const EncodeTable& table, const unsigned char* data, size_t size,
+		unsigned int streams, unsigned char* out, size_t* stream_sizes);
+
+	// Decodes raw_size symbols from streams laid out the same way, stream j
+	// starting at data[j] and being sizes[j] bytes long. Returns the OR of
+	// all the symbols, so invalid codes can be checked for once.
+	// Throws std::ios_base::failure if a stream ends early.
+	unsigned int (*decode)(const DecodeTable& table, const unsigned char* const* data, const size_t* sizes,
+		unsigned int streams, size_t raw_size, unsigned char* out);
+	// Same, looking codes up in multi first, which must not be empty
+	unsigned int (*decode_multi)(const MultiDecodeTable& multi, const DecodeTable& table,
+		const unsigned char* const* data, const size_t* sizes, unsigned int streams, size_t raw_size, unsigned char* out);
+};
+
+enum BitKernelsVariant
+{
+	BIT_KERNELS_PORTABLE,
+	BIT_KERNELS_BMI2,
+	NUM_BIT_KERNELS
+};
+
+// Returns 0 if this build or CPU can't run the variant.
+const BitKernels* find_bit_kernels(BitKernelsVariant variant);
+
+// The fastest variant this CPU can run.
+const BitKernels& bit_kernels();
+
+#endif // YURIKS_BIT_KERNELS_H
@@ -44,7 +44,7 @@ void Bitstream::push_back(const Bitstream& stream)
 {
 	if (stream.length() >= 8)
 	{
-		for (unsigned long i = 0; i < (stream.length() >> 3)-1; ++i)
+		for (size_t i = 0; i < (stream.length() >> 3); ++i)
 		{
 			push_back(stream.store[i]);
 		}
@@ -68,7 +68,7 @@ void Bitstream::push_back(unsigned char byte)
 {
 	for (int i = 0; i < 8; ++i)
 	{
-		push_back((byte & 0x80) == 1);
+		push_back((byte & 0x80) != 0);
 		byte <<= 1;
 	}
 }
@@ -76,28 +76,15 @@ void Bitstream::push_back(unsigned char byte)
 ///////////////////////////////////////////////////////////////////////////////
 
 OFileBitstream::OFileBitstream(std::ostream& f)
-	: file(f), cur_char(0), cur_char_len(0)
+	: file(f), buffer(256 * 1024), buffer_pos(0), flushed(0), acc(0), acc_len(0)
 {
 }
 
-void OFileBitstream::push_back(bool bit)
-{
-	cur_char <<= 1;
-	cur_char |= (bit ? 1 : 0);
-	
-	if (++cur_char_len == 8)
-	{
-		file.put(cur_char);
-		cur_char = 0;
-		cur_char_len = 0;
-	}
-}
-
 void OFileBitstream::push_back(const Bitstream& stream)
 {
 	if (stream.length() >= 8)
 	{
-		for (unsigned long i = 0; i < (stream.length() >> 3); ++i)
+		for (size_t i = 0; i < (stream.length() >> 3); ++i)
 		{
 			push_back(stream.store[i]);
 		}
@@ -105,67 +92,167 @@ void OFileBitstream::push_back(const Bitstream& stream)
 
 	if ((stream.length() & 0x7) != 0)
 	{
-		unsigned char byte = stream.store[stream.length() >> 3];
 		int i = stream.length() & 0x7;
-
-		byte <<= (8-i);
-		for (; i > 0; --i)
-		{
-			push_back((byte & 0x80) != 0);
-			byte <<= 1;
-		}
+		pushWordBits(stream.store[stream.length() >> 3], i);
 	}
 }
 
-void OFileBitstream::push_back(unsigned char byte)
+void OFileBitstream::flushBuffer()
 {
-	for (int i = 0; i < 8; ++i)
+	file.write(reinterpret_cast<const char*>(&buffer[0]), buffer_pos);
+	flushed += buffer_pos;
+	buffer_pos = 0;
+}
+
+void OFileBitstream::flush()
+{
+	for (; acc_len >= 8; acc_len -= 8)
 	{
-		push_back((byte & 0x80) != 0);
-		byte <<= 1;
+		if (buffer_pos == buffer.size())
+			flushBuffer();
+		buffer[buffer_pos++] = static_cast<unsigned char>(acc >> (acc_len - 8));
 	}
+
+	flushBuffer();
+	file.flush();
 }
 
 OFileBitstream::~OFileBitstream()
 {
 	// flush remaining bits
-	if (cur_char_len > 0)
+	if ((acc_len & 0x7) != 0)
 	{
 		// pad with 0
-		while (cur_char_len != 0)
-			push_back(false);
+		pushWordBits(0, 8 - (acc_len & 0x7));
 	}
+
+	if (buffer.size() - buffer_pos < 4)
+		flushBuffer();
+
+	for (; acc_len > 0; acc_len -= 8)
+		buffer[buffer_pos++] = static_cast<unsigned char>(acc >> (acc_len - 8));
+
+	flushBuffer();
 }
 
-IFileBitstream::IFileBitstream(std::ifstream& f) 
-	: file(f), current_char(0), current_pos(0)
+IFileBitstream::IFileBitstream(std::istream& f, bool live)
+	: file(f), live(live), buffer(64 * 1024), buffer_pos(0), buffer_end(0), file_pos(0),
+	bit_buf(0), bit_count(0), pad_bits(0)
 {
-	f.exceptions(std::ifstream::eofbit | std::ifstream::badbit | std::ifstream::failbit);
 }
 
-bool IFileBitstream::nextBit()
+void IFileBitstream::refill(int n)
 {
-  if (current_pos == 0) 
-	  current_char = file.get();
+	// Same word refill as IMemoryBitstream while the buffer has 8 bytes
+	if (buffer_end - buffer_pos >= 8)
+	{
+		bit_buf |= load_be64(&buffer[buffer_pos]) >> bit_count;
+		buffer_pos += (63 - bit_count) >> 3;
+		bit_count |= 56;
+		return;
+	}
+
+	while (bit_count <= 56)
+	{
+		if (buffer_pos == buffer_end)
+		{
+			if (live && bit_count >= n && file.rdbuf()->in_avail() <= 0)
+				return;
+			fill();
+		}
 
-  bool bit = (current_char & 0x80) != 0;
-  current_char <<= 1;
+		unsigned long long byte = 0;
+		if (buffer_pos != buffer_end)
+			byte = buffer[buffer_pos++];
+		else
+			pad_bits += 8;
 
-  if (++current_pos == 8)
-    current_pos = 0;
-  
-  return bit;
+		bit_buf |= byte << (56 - bit_count);
+		bit_count += 8;
+	}
 }
 
-unsigned char IFileBitstream::nextChar()
+void IFileBitstream::fill()
 {
-	unsigned char a = 0;
+	buffer_pos = 0;
+	buffer_end = 0;
+	if (!file)
+		return;
 
-	for(int i = 0; i < 8; ++i) 
+	char* p = reinterpret_cast<char*>(&buffer[0]);
+	if (live)
 	{
-		a <<= 1;
-		a |= nextBit() ? 1 : 0;
+		// Waits for a single byte, then takes whatever else has arrived
+		if (file.rdbuf()->in_avail() <= 0)
+		{
+			file.read(p, 1);
+			buffer_end = static_cast<size_t>(file.gcount());
+		}
+		if (file)
+			buffer_end += static_cast<size_t>(file.readsome(p + buffer_end, buffer.size() - buffer_end));
 	}
+	else
+	{
+		file.read(p, buffer.size());
+		buffer_end = static_cast<size_t>(file.gcount());
+	}
+
+	file_pos += buffer_end;
+}
+
+void IFileBitstream::underflow()
+{
+	throw std::ios_base::failure("unexpected end of compressed stream");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OMemoryBitstream::push_back(const Bitstream& stream)
+{
+	for (size_t i = 0; i < (stream.length() >> 3); ++i)
+		push_back(stream.store[i]);
+
+	if ((stream.length() & 0x7) != 0)
+		pushWordBits(stream.store[stream.length() >> 3], stream.length() & 0x7);
+}
+
+size_t OMemoryBitstream::finish()
+{
+	if ((acc_len & 0x7) != 0)
+		pushWordBits(0, 8 - (acc_len & 0x7));
 
-	return a;
+	for (; acc_len > 0; acc_len -= 8)
+		*out++ = static_cast<unsigned char>(acc >> (acc_len - 8));
+
+	return out - begin;
+}
+
+IMemoryBitstream::IMemoryBitstream()
+	: begin(0), cur(0), end(0), bit_buf(0), bit_count(0), pad_bits(0)
+{
+}
+
+IMemoryBitstream::IMemoryBitstream(const unsigned char* data, size_t size)
+	: begin(data), cur(data), end(data + size), bit_buf(0), bit_count(0), pad_bits(0)
+{
+}
+
+void IMemoryBitstream::refillTail()
+{
+	while (bit_count <= 56)
+	{
+		unsigned long long byte = 0;
+		if (cur != end)
+			byte = *cur++;
+		else
+			pad_bits += 8;
+
+		bit_buf |= byte << (56 - bit_count);
+		bit_count += 8;
+	}
+}
+
+void IMemoryBitstream::underflow()
+{
+	throw std::ios_base::failure("unexpected end of compressed block");
 }
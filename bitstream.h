@@ -27,9 +27,40 @@
 
 #include <vector>
 #include <cassert>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
+#if defined(_MSC_VER)
+#	include <stdlib.h>
+#endif
+
+// Big-endian words, in the order the streams keep their bits. Both are a
+// single load or store and a byte swap.
+inline unsigned long long load_be64(const unsigned char* p)
+{
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	unsigned long long v;
+	std::memcpy(&v, p, 8);
+	return __builtin_bswap64(v);
+#elif defined(_MSC_VER)
+	unsigned long long v;
+	std::memcpy(&v, p, 8);
+	return _byteswap_uint64(v);
+#else
+	unsigned long long v = 0;
+	for (int i = 0; i < 8; ++i)
+		v = (v << 8) | p[i];
+	return v;
+#endif
+}
+
+inline void store_be32(unsigned char* p, unsigned int v)
+{
+	for (int i = 0; i < 4; ++i)
+		p[i] = static_cast<unsigned char>(v >> (24 - 8 * i));
+}
+
 class Bitstream
 {
 public:
@@ -38,14 +69,15 @@ public:
 	void push_back(bool bit);
 	void push_back(const Bitstream& stream);
 	void push_back(unsigned char byte);
-	unsigned long length() const;
-	//bool at(unsigned long i) const;
+	size_t length() const;
+	//bool at(size_t i) const;
 
 private:
 	std::vector<unsigned char> store;
-	unsigned long length_;
+	size_t length_;
 
 	friend class OFileBitstream;
+	friend class OMemoryBitstream;
 };
 
 inline Bitstream::Bitstream()
@@ -53,7 +85,7 @@ inline Bitstream::Bitstream()
 {
 }
 
-inline unsigned long Bitstream::length() const
+inline size_t Bitstream::length() const
 {
 	return length_;
 }
@@ -66,26 +98,325 @@ public:
 	void push_back(bool bit);
 	void push_back(const Bitstream& stream);
 	void push_back(unsigned char byte);
+	// Writes the low `length` (<= 64) bits of `bits`, MSB first.
+	void pushBits(unsigned long long bits, int length);
+
+	// Number of bits pushed so far.
+	unsigned long long bitsWritten() const;
+
+	// Writes out every whole byte pushed so far and flushes the file, for
+	// live streams. The bits of an unfinished byte stay pending.
+	void flush();
 
 	~OFileBitstream();
 
 private:
+	void pushWordBits(unsigned int bits, int length);
+	void flushBuffer();
+
 	std::ostream& file;
-	unsigned char cur_char;
-	int cur_char_len;
+	std::vector<unsigned char> buffer;
+	size_t buffer_pos;
+	unsigned long long flushed;
+
+	// Pending bits, right-aligned. Always less than 32 between calls.
+	unsigned long long acc;
+	int acc_len;
 };
 
+inline void OFileBitstream::pushWordBits(unsigned int bits, int length)
+{
+	acc = (acc << length) | bits;
+	acc_len += length;
+
+	if (acc_len >= 32)
+	{
+		acc_len -= 32;
+		unsigned int word = static_cast<unsigned int>(acc >> acc_len);
+
+		if (buffer.size() - buffer_pos < 4)
+			flushBuffer();
+
+		store_be32(&buffer[buffer_pos], word);
+		buffer_pos += 4;
+	}
+}
+
+inline void OFileBitstream::pushBits(unsigned long long bits, int length)
+{
+	if (length > 32)
+	{
+		pushWordBits(static_cast<unsigned int>(bits >> 32), length - 32);
+		length = 32;
+	}
+
+	pushWordBits(static_cast<unsigned int>(bits & ((1ULL << length) - 1)), length);
+}
+
+inline unsigned long long OFileBitstream::bitsWritten() const
+{
+	return (flushed + buffer_pos) * 8 + acc_len;
+}
+
+inline void OFileBitstream::push_back(bool bit)
+{
+	pushWordBits(bit ? 1 : 0, 1);
+}
+
+inline void OFileBitstream::push_back(unsigned char byte)
+{
+	pushWordBits(byte, 8);
+}
+
 class IFileBitstream
 {
 public:
-	IFileBitstream(std::ifstream& f);
+	// A live stream only reads what has already arrived and doesn't wait
+	// for more while it has enough bits for the caller, so data from a pipe
+	// is decoded as soon as it is written.
+	IFileBitstream(std::istream& f, bool live = false);
 
 	bool nextBit();
 	unsigned char nextChar();
+
+	// Returns the next n (<= 32) bits, MSB first, without consuming them.
+	// Bits past the end of the file read as 0.
+	unsigned int peekBits(int n);
+	// Consumes n (<= 32) bits. Throws std::ios_base::failure if that goes
+	// past the end of the file.
+	void skipBits(int n);
+
+	// Number of whole bytes consumed from the file so far.
+	unsigned long long bytesConsumed() const;
+
+	// True when all input that has arrived is in the bit buffer, so reading
+	// past it may have to wait. Always false if the stream isn't live.
+	bool drained() const;
+
 private:
-	std::ifstream& file;
-	unsigned char current_char;
-	unsigned int current_pos;
+	void refill(int n);
+	void fill();
+	void underflow();
+
+	std::istream& file;
+	bool live;
+	std::vector<unsigned char> buffer;
+	size_t buffer_pos;
+	size_t buffer_end;
+	unsigned long long file_pos;
+
+	// Bits are kept left-aligned: the next bit to be read is the MSB.
+	unsigned long long bit_buf;
+	int bit_count;
+	// Number of zero bits at the end of bit_buf that were made up after EOF.
+	int pad_bits;
 };
 
+inline unsigned int IFileBitstream::peekBits(int n)
+{
+	if (bit_count < n)
+		refill(n);
+
+	// Two shifts so that n == 0 doesn't shift by 64
+	return static_cast<unsigned int>((bit_buf >> 1) >> (63 - n));
+}
+
+inline void IFileBitstream::skipBits(int n)
+{
+	bit_buf <<= n;
+	bit_count -= n;
+
+	if (bit_count < pad_bits)
+		underflow();
+}
+
+inline bool IFileBitstream::nextBit()
+{
+	bool bit = peekBits(1) != 0;
+	skipBits(1);
+	return bit;
+}
+
+inline unsigned char IFileBitstream::nextChar()
+{
+	unsigned char c = static_cast<unsigned char>(peekBits(8));
+	skipBits(8);
+	return c;
+}
+
+inline unsigned long long IFileBitstream::bytesConsumed() const
+{
+	return file_pos - (buffer_end - buffer_pos) - (bit_count - pad_bits) / 8;
+}
+
+inline bool IFileBitstream::drained() const
+{
+	return live && buffer_pos == buffer_end && file.rdbuf()->in_avail() <= 0;
+}
+
+// Bit writer over a caller-provided buffer, which must be big enough for
+// everything that is pushed. Same bit order as OFileBitstream.
+class OMemoryBitstream
+{
+public:
+	OMemoryBitstream(unsigned char* out);
+
+	void push_back(bool bit);
+	void push_back(const Bitstream& stream);
+	void push_back(unsigned char byte);
+	void pushBits(unsigned long long bits, int length);
+
+	// Pads the last byte with zeros and returns the number of bytes written.
+	size_t finish();
+
+private:
+	void pushWordBits(unsigned int bits, int length);
+
+	unsigned char* begin;
+	unsigned char* out;
+
+	unsigned long long acc;
+	int acc_len;
+};
+
+inline OMemoryBitstream::OMemoryBitstream(unsigned char* out)
+	: begin(out), out(out), acc(0), acc_len(0)
+{
+}
+
+inline void OMemoryBitstream::pushWordBits(unsigned int bits, int length)
+{
+	acc = (acc << length) | bits;
+	acc_len += length;
+
+	if (acc_len >= 32)
+	{
+		acc_len -= 32;
+		unsigned int word = static_cast<unsigned int>(acc >> acc_len);
+
+		store_be32(out, word);
+		out += 4;
+	}
+}
+
+inline void OMemoryBitstream::pushBits(unsigned long long bits, int length)
+{
+	if (length > 32)
+	{
+		pushWordBits(static_cast<unsigned int>(bits >> 32), length - 32);
+		length = 32;
+	}
+
+	pushWordBits(static_cast<unsigned int>(bits & ((1ULL << length) - 1)), length);
+}
+
+inline void OMemoryBitstream::push_back(bool bit)
+{
+	pushWordBits(bit ? 1 : 0, 1);
+}
+
+inline void OMemoryBitstream::push_back(unsigned char byte)
+{
+	pushWordBits(byte, 8);
+}
+
+// Bit reader over a buffer in memory. Same interface as IFileBitstream.
+class IMemoryBitstream
+{
+public:
+	// Empty stream, so arrays of readers can be assigned to later
+	IMemoryBitstream();
+	IMemoryBitstream(const unsigned char* data, size_t size);
+
+	bool nextBit();
+	unsigned char nextChar();
+	unsigned int peekBits(int n);
+	void skipBits(int n);
+
+	// Tops up to at least 56 bits, which can then be peeked with
+	// peekBuffered without checking, for decoders that know how long
+	// their codes can be and take several per refill.
+	void fillBuffer();
+	unsigned int peekBuffered(int n) const;
+
+	// Number of whole bytes consumed so far.
+	size_t bytesConsumed() const;
+
+private:
+	void refill();
+	void refillTail();
+	void underflow();
+
+	const unsigned char* begin;
+	const unsigned char* cur;
+	const unsigned char* end;
+
+	unsigned long long bit_buf;
+	int bit_count;
+	int pad_bits;
+};
+
+// Tops up to at least 56 bits with one 8 byte load and no branches, as
+// long as 8 bytes are left. Bits past bit_count are the stream's next bits
+// too, so loading them again later changes nothing.
+inline void IMemoryBitstream::refill()
+{
+	if (end - cur < 8)
+	{
+		refillTail();
+		return;
+	}
+
+	bit_buf |= load_be64(cur) >> bit_count;
+	cur += (63 - bit_count) >> 3;
+	bit_count |= 56;
+}
+
+inline unsigned int IMemoryBitstream::peekBits(int n)
+{
+	if (bit_count < n)
+		refill();
+
+	return static_cast<unsigned int>((bit_buf >> 1) >> (63 - n));
+}
+
+inline void IMemoryBitstream::skipBits(int n)
+{
+	bit_buf <<= n;
+	bit_count -= n;
+
+	if (bit_count < pad_bits)
+		underflow();
+}
+
+inline void IMemoryBitstream::fillBuffer()
+{
+	if (bit_count < 56)
+		refill();
+}
+
+inline unsigned int IMemoryBitstream::peekBuffered(int n) const
+{
+	return static_cast<unsigned int>((bit_buf >> 1) >> (63 - n));
+}
+
+inline bool IMemoryBitstream::nextBit()
+{
+	bool bit = peekBits(1) != 0;
+	skipBits(1);
+	return bit;
+}
+
+inline unsigned char IMemoryBitstream::nextChar()
+{
+	unsigned char c = static_cast<unsigned char>(peekBits(8));
+	skipBits(8);
+	return c;
+}
+
+inline size_t IMemoryBitstream::bytesConsumed() const
+{
+	return (cur - begin) - (bit_count - pad_bits) / 8;
+}
+
 #endif // YURIKS_BITSTREAM_H
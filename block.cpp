@@ -0,0 +1,418 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "block.h"
+#include "bit_kernels.h"
+#include "bitstream.h"
+#include "histogram.h"
+#include "shared_table.h"
+
+#include <cstring>
+#include <ios>
+
+namespace
+{
+
+const SharedTable* lookup_shared_table(unsigned int id, BlockTables& tables)
+{
+	unsigned int generation = shared_table_generation();
+	if (tables.shared == 0 || tables.shared_id != id || tables.shared_generation != generation)
+	{
+		tables.shared = find_shared_table(id);
+		tables.shared_id = id;
+		tables.shared_generation = generation;
+	}
+	return tables.shared;
+}
+
+size_t encode_interleaved(const EncodeTable& table, const unsigned char* data, size_t size, unsigned int streams, unsigned char* out)
+{
+	unsigned char* sizes = out + 1;
+	unsigned char* payload = sizes + 4 * (streams - 1);
+
+	out[0] = static_cast<unsigned char>(streams);
+
+	size_t stream_sizes[BLOCK_MAX_STREAMS];
+	size_t payload_size = bit_kernels().encode(table, data, size, streams, payload, stream_sizes);
+
+	for (unsigned int j = 0; j + 1 < streams; ++j)
+		store_u32(sizes + 4 * j, static_cast<unsigned int>(stream_sizes[j]));
+
+	return payload + payload_size - out;
+}
+
+unsigned int decode_streams(const DecodeTable& table, const MultiDecodeTable* multi, const unsigned char* const* data,
+	const size_t* sizes, unsigned int streams, size_t raw_size, unsigned char* out)
+{
+	if (multi != 0)
+		return bit_kernels().decode_multi(*multi, table, data, sizes, streams, raw_size, out);
+	return bit_kernels().decode(table, data, sizes, streams, raw_size, out);
+}
+
+unsigned int decode_single(const DecodeTable& table, const MultiDecodeTable* multi,
+	const unsigned char* data, size_t size, size_t raw_size, unsigned char* out)
+{
+	return decode_streams(table, multi, &data, &size, 1, raw_size, out);
+}
+
+unsigned int decode_interleaved(const DecodeTable& table, const MultiDecodeTable* multi,
+	const unsigned char* data, size_t size, size_t raw_size, unsigned char* out)
+{
+	unsigned int streams = size > 0 ? data[0] : 0;
+	if (streams < 1 || streams > BLOCK_MAX_STREAMS || size < 1 + 4 * (streams - 1))
+		throw std::ios_base::failure("invalid stream count");
+
+	const unsigned char* payload = data + 1 + 4 * (streams - 1);
+	size_t payload_size = size - (payload - data);
+
+	const unsigned char* stream_data[BLOCK_MAX_STREAMS];
+	size_t stream_sizes[BLOCK_MAX_STREAMS];
+
+	size_t pos = 0;
+	for (unsigned int j = 0; j < streams; ++j)
+	{
+		size_t stream_size = payload_size - pos;
+		if (j + 1 < streams)
+			stream_size = load_u32(data + 1 + 4 * j);
+		if (stream_size > payload_size - pos)
+			throw std::ios_base::failure("invalid stream size");
+
+		stream_data[j] = payload + pos;
+		stream_sizes[j] = stream_size;
+		pos += stream_size;
+	}
+
+	return decode_streams(table, multi, stream_data, stream_sizes, streams, raw_size, out);
+}
+
+int multi_decode_bits(const MultiDecodeOptions& options, size_t raw_size)
+{
+	if (raw_size < options.min_block_size)
+		return 0;
+
+	int bits = 0;
+	while (bits < options.bits && (options.bytes_per_entry << (bits + 1)) <= raw_size)
+		++bits;
+
+	return bits;
+}
+
+size_t store_block(unsigned char type, const unsigned char* data, size_t data_size, size_t raw_size, unsigned char* out, Stats* stats)
+{
+	BlockHeader header;
+	header.type = type;
+	header.raw_size = static_cast<unsigned int>(raw_size);
+	header.data_size = static_cast<unsigned int>(data_size);
+	write_block_header(out, header);
+
+	std::memcpy(out + BLOCK_HEADER_SIZE, data, data_size);
+
+	if (stats != 0)
+	{
+		stats->symbols += raw_size;
+		stats->bits += data_size * 8;
+	}
+
+	return BLOCK_HEADER_SIZE + data_size;
+}
+
+} // namespace
+
+MultiDecodeOptions::MultiDecodeOptions()
+	: bits(MultiDecodeTable::default_bits), symbols(MultiDecodeTable::max_symbols), bytes_per_entry(32),
+	min_block_size(32 * 1024)
+{
+}
+
+BlockTables::BlockTables()
+	: shared(0), shared_id(0), shared_generation(0)
+{
+}
+
+BlockOptions::BlockOptions()
+	: max_code_length(HUFFMAN_DEFAULT_MAX_CODE_LENGTH), streams(BLOCK_DEFAULT_STREAMS), table_id(0),
+	context_groups(0), stats(0)
+{
+}
+
+size_t compressed_block_bound(size_t raw_size)
+{
+	// Every stream may end with a partial byte
+	return BLOCK_HEADER_SIZE + CODE_LENGTHS_SIZE + 1 + 4 * (BLOCK_MAX_STREAMS - 1) +
+		(raw_size * HUFFMAN_MAX_CODE_LENGTH + 7) / 8 + BLOCK_MAX_STREAMS;
+}
+
+void compress_block(const unsigned char* data, size_t size, const BlockOptions& options, std::vector<unsigned char>& out)
+{
+	BlockTables tables;
+
+	size_t start = out.size();
+	out.resize(start + compressed_block_bound(size));
+	size_t block_size = compress_block(data, size, options, &out[start], tables);
+	out.resize(start + block_size);
+}
+
+size_t compress_block(const unsigned char* data, size_t size, const BlockOptions& options, unsigned char* out, BlockTables& tables)
+{
+	Stats* stats = options.stats;
+
+	unsigned char* p = out + BLOCK_HEADER_SIZE;
+	const EncodeTable* table = 0;
+	size_t code_size;
+
+	BlockHeader header;
+	header.raw_size = static_cast<unsigned int>(size);
+
+	if (options.table_id != 0)
+	{
+		const SharedTable* shared = lookup_shared_table(options.table_id, tables);
+		if (shared == 0)
+			throw std::ios_base::failure("unknown shared table");
+
+		// Always interleaved, a single stream only costs the count byte
+		header.type = BLOCK_SHARED;
+		table = &shared->encodeTable();
+		store_u32(p, shared->id());
+		code_size = 4;
+	}
+	else
+	{
+		PhaseTimer histogram_timer(stats, PHASE_HISTOGRAM);
+		unsigned long long counts[HUFFMAN_NUM_SYMBOLS];
+		histogram(data, size, counts);
+		counts[HUFFMAN_EOF] = 0; // The header has the size
+		histogram_timer.stop();
+
+		// A run of one byte value, such as a block of zeros
+		unsigned int distinct = 0;
+		for (unsigned int i = 0; i < HISTOGRAM_SIZE; ++i)
+			distinct += counts[i] != 0 ? 1 : 0;
+		if (distinct == 1)
+			return store_block(BLOCK_RLE, data, 1, size, out, stats);
+
+		PhaseTimer tree_timer(stats, PHASE_TREE);
+		unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+		tables.builder.build(counts, options.max_code_length, lengths);
+
+		// The code lengths give the exact coded size before coding anything
+		unsigned long long bits = 0;
+		for (unsigned int i = 0; i < HISTOGRAM_SIZE; ++i)
+			bits += counts[i] * lengths[i];
+		size_t order0_size = CODE_LENGTHS_SIZE + static_cast<size_t>((bits + 7) / 8);
+
+		header.type = BLOCK_HUFFMAN;
+		size_t estimate = order0_size;
+		if (options.streams > 1)
+		{
+			// Stream count, stream sizes and a partial byte per stream
+			header.type = BLOCK_HUFFMAN_INTERLEAVED;
+			estimate += 1 + 5 * (options.streams - 1);
+		}
+
+		// Only taken when smaller than a single order-0 stream, which keeps
+		// the block within compressed_block_bound.
+		if (options.context_groups > 1 && size > 0)
+		{
+			size_t order1_size = tables.context.build(data, size, options.context_groups, options.max_code_length, tables.builder);
+			if (order1_size < order0_size)
+			{
+				header.type = BLOCK_ORDER1;
+				estimate = order1_size;
+			}
+		}
+		tree_timer.stop();
+
+		// Already compressed or random data, coding it would only add to it
+		if (estimate >= size)
+			return store_block(BLOCK_RAW, data, size, size, out, stats);
+
+		// Order-1 blocks code with the tables of tables.context instead
+		if (header.type != BLOCK_ORDER1)
+		{
+			tables.encode.build(lengths);
+			table = &tables.encode;
+		}
+
+		PhaseTimer header_timer(stats, PHASE_HEADER);
+		if (header.type == BLOCK_ORDER1)
+		{
+			code_size = tables.context.writeHeader(p);
+		}
+		else
+		{
+			OMemoryBitstream length_stream(p);
+			write_code_lengths(length_stream, lengths);
+			code_size = length_stream.finish();
+		}
+		header_timer.stop();
+	}
+
+	size_t data_size = code_size;
+
+	PhaseTimer encode_timer(stats, PHASE_ENCODE);
+	if (header.type == BLOCK_ORDER1)
+	{
+		data_size += tables.context.encode(data, size, p + data_size);
+	}
+	else if (header.type != BLOCK_HUFFMAN)
+	{
+		data_size += encode_interleaved(*table, data, size, options.streams, p + data_size);
+	}
+	else
+	{
+		size_t stream_size;
+		data_size += bit_kernels().encode(*table, data, size, 1, p + data_size, &stream_size);
+	}
+	encode_timer.stop();
+
+	if (stats != 0)
+	{
+		stats->symbols += size;
+		stats->bits += (data_size - code_size) * 8;
+	}
+
+	header.data_size = static_cast<unsigned int>(data_size);
+	write_block_header(out, header);
+
+	return BLOCK_HEADER_SIZE + header.data_size;
+}
+
+void write_block_header(unsigned char* p, const BlockHeader& header)
+{
+	p[0] = header.type;
+	store_u32(p + 1, header.raw_size);
+	store_u32(p + 5, header.data_size);
+}
+
+BlockHeader read_block_header(const unsigned char* p)
+{
+	BlockHeader header;
+	header.type = p[0];
+	header.raw_size = load_u32(p + 1);
+	header.data_size = load_u32(p + 5);
+	return header;
+}
+
+void decompress_block(const BlockHeader& header, const unsigned char* data, unsigned char* out, Stats* stats)
+{
+	BlockTables tables;
+	decompress_block(header, data, out, tables, stats);
+}
+
+void decompress_block(const BlockHeader& header, const unsigned char* data, unsigned char* out, BlockTables& tables, Stats* stats)
+{
+	if (header.type == BLOCK_RAW || header.type == BLOCK_RLE)
+	{
+		PhaseTimer decode_timer(stats, PHASE_DECODE);
+
+		if (header.type == BLOCK_RAW && header.data_size == header.raw_size)
+			std::memcpy(out, data, header.raw_size);
+		else if (header.type == BLOCK_RLE && header.data_size == 1)
+			std::memset(out, data[0], header.raw_size);
+		else
+			throw std::ios_base::failure("invalid stored block");
+
+		if (stats != 0)
+		{
+			stats->symbols += header.raw_size;
+			stats->bits += header.data_size * 8ULL;
+		}
+		return;
+	}
+
+	const DecodeTable* table;
+	// 0 to decode one symbol at a time
+	const MultiDecodeTable* multi = 0;
+	size_t code_size;
+
+	if (header.type == BLOCK_SHARED)
+	{
+		if (header.data_size < 4)
+			throw std::ios_base::failure("unexpected end of compressed block");
+
+		const SharedTable* shared = lookup_shared_table(load_u32(data), tables);
+		if (shared == 0)
+			throw std::ios_base::failure("block needs a shared table that wasn't given");
+
+		table = &shared->decodeTable();
+		if (tables.multi.bits != 0 && !shared->multiDecodeTable().empty())
+			multi = &shared->multiDecodeTable();
+		code_size = 4;
+	}
+	else if (header.type == BLOCK_HUFFMAN || header.type == BLOCK_HUFFMAN_INTERLEAVED)
+	{
+		if (header.data_size < CODE_LENGTHS_SIZE)
+			throw std::ios_base::failure("unexpected end of compressed block");
+
+		PhaseTimer header_timer(stats, PHASE_HEADER);
+		IMemoryBitstream length_stream(data, CODE_LENGTHS_SIZE);
+		unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+		read_code_lengths(length_stream, lengths);
+		header_timer.stop();
+
+		PhaseTimer tree_timer(stats, PHASE_TREE);
+		tables.decode.build(lengths);
+		table = &tables.decode;
+		int multi_bits = multi_decode_bits(tables.multi, header.raw_size);
+		if (multi_bits != 0 && tables.multi_decode.build(lengths, multi_bits, tables.multi.symbols))
+			multi = &tables.multi_decode;
+		tree_timer.stop();
+
+		code_size = CODE_LENGTHS_SIZE;
+	}
+	else if (header.type == BLOCK_ORDER1)
+	{
+		PhaseTimer header_timer(stats, PHASE_HEADER);
+		code_size = tables.context.readHeader(data, header.data_size);
+		header_timer.stop();
+
+		table = 0;
+	}
+	else
+	{
+		throw std::ios_base::failure("unknown block type");
+	}
+
+	PhaseTimer decode_timer(stats, PHASE_DECODE);
+
+	const unsigned char* payload = data + code_size;
+	size_t payload_size = header.data_size - code_size;
+
+	// Symbols past 0xFF only come from corrupt data, check them once at the end
+	unsigned int symbols;
+	if (header.type == BLOCK_ORDER1)
+		symbols = tables.context.decode(payload, payload_size, header.raw_size, out);
+	else if (header.type == BLOCK_HUFFMAN)
+		symbols = decode_single(*table, multi, payload, payload_size, header.raw_size, out);
+	else
+		symbols = decode_interleaved(*table, multi, payload, payload_size, header.raw_size, out);
+
+	if (symbols > 0xFF)
+		throw std::ios_base::failure("invalid code");
+
+	if (stats != 0)
+	{
+		stats->symbols += header.raw_size;
+		stats->bits += payload_size * 8;
+	}
+}
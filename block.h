@@ -0,0 +1,178 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_BLOCK_H
+#define YURIKS_BLOCK_H
+
+#include "canonical.h"
+#include "context_model.h"
+#include "decode_table.h"
+#include "encode_table.h"
+#include "multi_decode_table.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <vector>
+
+class SharedTable;
+
+// A block is a BLOCK_HEADER_SIZE byte header followed by data_size bytes
+// whose layout depends on the block type.
+enum BlockType
+{
+	BLOCK_HUFFMAN = 0,             // Code lengths, then the canonical coded bytes
+	BLOCK_HUFFMAN_INTERLEAVED = 1, // Code lengths, u8 stream count, u32 size of
+	                               // every stream but the last, then the streams.
+	                               // Byte i is coded in stream i % count.
+	BLOCK_SHARED = 2,              // u32 shared table ID, then the streams as in
+	                               // BLOCK_HUFFMAN_INTERLEAVED
+	BLOCK_ORDER1 = 3,              // ContextModel header, then one stream
+	BLOCK_RAW = 4,                 // The raw bytes, for data that doesn't compress
+	BLOCK_RLE = 5,                 // One byte, repeated raw_size times
+	BLOCK_END = 0xFF               // No data, marks the end of the blocks
+};
+
+enum
+{
+	BLOCK_HEADER_SIZE = 9,
+	BLOCK_MAX_STREAMS = 8,
+	BLOCK_DEFAULT_STREAMS = 4
+};
+
+struct BlockOptions
+{
+	BlockOptions();
+
+	unsigned int max_code_length;
+	// Interleaved sub-streams sharing the block's code. Independent streams
+	// let the decoder work on several symbols at once.
+	unsigned int streams;
+	// ID of a registered SharedTable to code every block with, instead of
+	// building a code for each one. 0 for none.
+	unsigned int table_id;
+	// Most codes an order-1 block may pick from by the previous byte, up to
+	// CONTEXT_MAX_GROUPS. Blocks where that doesn't pay for its larger
+	// header are coded as usual. 0 or 1 for order-0 only.
+	unsigned int context_groups;
+	// Optional, shared by all blocks
+	Stats* stats;
+};
+
+// When blocks are decoded with a MultiDecodeTable
+struct MultiDecodeOptions
+{
+	MultiDecodeOptions();
+
+	// Widest index, up to MultiDecodeTable::max_bits. 0 to always decode
+	// one symbol at a time.
+	int bits;
+	// Most symbols per lookup, 2 to MultiDecodeTable::max_symbols
+	int symbols;
+	// Blocks with their own code get an index narrow enough that the table
+	// has at most one entry per this many of their raw bytes, which keeps
+	// the cost of building it in proportion to the block.
+	size_t bytes_per_entry;
+	// Smaller blocks don't build a table at all. Blocks coded with a shared
+	// table use the one built along with it, whatever their size.
+	size_t min_block_size;
+};
+
+// Code tables and scratch space for coding blocks. Reusing one for every
+// block keeps their memory, so coding stops allocating after the first few
+// blocks. Not shared between threads.
+struct BlockTables
+{
+	BlockTables();
+
+	CodeLengthBuilder builder;
+	EncodeTable encode;
+	DecodeTable decode;
+	MultiDecodeTable multi_decode;
+	MultiDecodeOptions multi;
+	ContextModel context;
+
+	// Last shared table looked up, kept while shared_table_generation()
+	// stays the same, so coding many small blocks doesn't search the
+	// registry for every one
+	const SharedTable* shared;
+	unsigned int shared_id;
+	unsigned int shared_generation;
+};
+
+struct BlockHeader
+{
+	unsigned char type;
+	unsigned int raw_size;
+	unsigned int data_size;
+};
+
+// Largest block, header included, that compress_block can produce for
+// raw_size bytes.
+size_t compressed_block_bound(size_t raw_size);
+
+// Compresses size bytes from data into a single block, appended to out.
+void compress_block(const unsigned char* data, size_t size, const BlockOptions& options, std::vector<unsigned char>& out);
+// Compresses into out, which must have room for compressed_block_bound(size)
+// bytes, and returns the size of the block, header included.
+size_t compress_block(const unsigned char* data, size_t size, const BlockOptions& options, unsigned char* out, BlockTables& tables);
+
+void write_block_header(unsigned char* p, const BlockHeader& header);
+BlockHeader read_block_header(const unsigned char* p);
+
+// Decodes the data_size bytes at data into the raw_size bytes at out.
+// Throws std::ios_base::failure if the block is corrupt.
+void decompress_block(const BlockHeader& header, const unsigned char* data, unsigned char* out, Stats* stats = 0);
+void decompress_block(const BlockHeader& header, const unsigned char* data, unsigned char* out, BlockTables& tables, Stats* stats = 0);
+
+///////////////////////////////////////////////////////////////////////////////
+// Little-endian integers used by the block and container headers
+
+inline void store_u32(unsigned char* p, unsigned int v)
+{
+	for (int i = 0; i < 4; ++i)
+		p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+inline void store_u64(unsigned char* p, unsigned long long v)
+{
+	for (int i = 0; i < 8; ++i)
+		p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+inline unsigned int load_u32(const unsigned char* p)
+{
+	unsigned int v = 0;
+	for (int i = 3; i >= 0; --i)
+		v = (v << 8) | p[i];
+	return v;
+}
+
+inline unsigned long long load_u64(const unsigned char* p)
+{
+	unsigned long long v = 0;
+	for (int i = 7; i >= 0; --i)
+		v = (v << 8) | p[i];
+	return v;
+}
+
+#endif // YURIKS_BLOCK_H
@@ -0,0 +1,240 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "canonical.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// Moffat and Katajainen's in-place Huffman code lengths. a holds n >= 2
+// weights in increasing order, and is left holding the code length of
+// each. The first pass merges like the two-queue method, keeping the
+// merged weights in the part of a already consumed and replacing them
+// with parent indices once they are merged in turn. The second turns
+// parent indices into depths of the internal nodes, and the third hands
+// out leaf depths from the number of internal nodes on each level.
+void minimum_redundancy(unsigned long long* a, unsigned int n)
+{
+	unsigned int root = 0;
+	unsigned int leaf = 2;
+
+	a[0] += a[1];
+	for (unsigned int next = 1; next < n - 1; ++next)
+	{
+		if (leaf >= n || a[root] < a[leaf])
+		{
+			a[next] = a[root];
+			a[root++] = next;
+		}
+		else
+		{
+			a[next] = a[leaf++];
+		}
+
+		if (leaf >= n || (root < next && a[root] < a[leaf]))
+		{
+			a[next] += a[root];
+			a[root++] = next;
+		}
+		else
+		{
+			a[next] += a[leaf++];
+		}
+	}
+
+	a[n-2] = 0;
+	for (int next = static_cast<int>(n) - 3; next >= 0; --next)
+		a[next] = a[a[next]] + 1;
+
+	int available = 1;
+	int used = 0;
+	unsigned long long depth = 0;
+	int internal = static_cast<int>(n) - 2;
+	int next = static_cast<int>(n) - 1;
+
+	while (available > 0)
+	{
+		while (internal >= 0 && a[internal] == depth)
+		{
+			++used;
+			--internal;
+		}
+		while (available > used)
+		{
+			a[next--] = depth;
+			--available;
+		}
+
+		available = 2 * used;
+		++depth;
+		used = 0;
+	}
+}
+
+} // namespace
+
+void build_code_lengths(const unsigned long long* frequency, unsigned int max_length, unsigned char* lengths)
+{
+	CodeLengthBuilder builder;
+	builder.build(frequency, max_length, lengths);
+}
+
+bool CodeLengthBuilder::lighter(const Item& a, const Item& b)
+{
+	return a.weight < b.weight;
+}
+
+bool CodeLengthBuilder::lighterLeaf(const Item& a, const Item& b)
+{
+	return a.weight < b.weight || (a.weight == b.weight && a.symbol < b.symbol);
+}
+
+void CodeLengthBuilder::build(const unsigned long long* frequency, unsigned int max_length, unsigned char* lengths)
+{
+	unsigned int n = 0;
+
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		lengths[i] = 0;
+
+		if (frequency[i] > 0)
+		{
+			Item item = { frequency[i], static_cast<int>(i), 0 };
+			leaves[n++] = item;
+		}
+	}
+
+	leaf_count = n;
+	if (n == 0)
+		return;
+	if (n == 1)
+	{
+		lengths[leaves[0].symbol] = 1;
+		return;
+	}
+
+	// std::stable_sort would need a temporary buffer
+	std::sort(leaves, leaves + n, lighterLeaf);
+
+	unsigned long long depth[HUFFMAN_NUM_SYMBOLS];
+	for (unsigned int i = 0; i < n; ++i)
+		depth[i] = leaves[i].weight;
+	minimum_redundancy(depth, n);
+
+	// The lightest symbol gets the longest code
+	if (depth[0] <= max_length)
+	{
+		for (unsigned int i = 0; i < n; ++i)
+			lengths[leaves[i].symbol] = static_cast<unsigned char>(depth[i]);
+		return;
+	}
+
+	packageMerge(max_length, lengths);
+}
+
+void CodeLengthBuilder::packageMerge(unsigned int max_length, unsigned char* lengths)
+{
+	while ((size_t(1) << max_length) < leaf_count)
+		++max_length;
+
+	if (levels.size() < max_length)
+		levels.resize(max_length);
+	levels[0].assign(leaves, leaves + leaf_count);
+
+	for (unsigned int k = 1; k < max_length; ++k)
+	{
+		const std::vector<Item>& prev = levels[k-1];
+		std::vector<Item>& cur = levels[k];
+
+		packages.clear();
+		for (size_t i = 0; i + 1 < prev.size(); i += 2)
+		{
+			Item item = { prev[i].weight + prev[i+1].weight, -1, static_cast<int>(i / 2) };
+			packages.push_back(item);
+		}
+
+		cur.resize(leaf_count + packages.size());
+		std::merge(leaves, leaves + leaf_count, packages.begin(), packages.end(), cur.begin(), lighter);
+	}
+
+	// Every time a leaf is picked in the 2n-2 cheapest items its code grows
+	// by one bit. Packages at index i pulled in items 0..2i+1 of the level
+	// below, since both lists are sorted.
+	int count = 2 * static_cast<int>(leaf_count) - 2;
+	const std::vector<Item>& last = levels[max_length-1];
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (last[i].symbol >= 0)
+			++lengths[last[i].symbol];
+	}
+
+	// Walk down the packages. The deepest package picked at each level
+	// determines how many items of the level below are used.
+	int level = max_length - 1;
+	while (level > 0)
+	{
+		int deepest = -1;
+		for (int i = 0; i < count; ++i)
+		{
+			if (levels[level][i].symbol < 0)
+				deepest = levels[level][i].package;
+		}
+		if (deepest < 0)
+			break;
+
+		count = 2 * (deepest + 1);
+		--level;
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (levels[level][i].symbol >= 0)
+				++lengths[levels[level][i].symbol];
+		}
+	}
+}
+
+void canonical_codes(const unsigned char* lengths, unsigned int* codes)
+{
+	unsigned int length_count[HUFFMAN_MAX_CODE_LENGTH+1] = { 0 };
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		++length_count[lengths[i]];
+	length_count[0] = 0;
+
+	unsigned int next_code[HUFFMAN_MAX_CODE_LENGTH+1];
+	unsigned int code = 0;
+	for (int len = 1; len <= HUFFMAN_MAX_CODE_LENGTH; ++len)
+	{
+		code = (code + length_count[len-1]) << 1;
+		next_code[len] = code;
+	}
+
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		codes[i] = 0;
+		if (lengths[i] != 0)
+			codes[i] = next_code[lengths[i]]++;
+	}
+}
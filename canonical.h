@@ -0,0 +1,134 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_CANONICAL_H
+#define YURIKS_CANONICAL_H
+
+#include "bitstream.h"
+#include "dictionary.h"
+
+#include <ios>
+#include <vector>
+
+enum CodeLengthLimits
+{
+	// Lengths are stored in 4 bits in the header
+	HUFFMAN_MAX_CODE_LENGTH = 15,
+	// Needed to give each of the HUFFMAN_NUM_SYMBOLS symbols a code
+	HUFFMAN_MIN_CODE_LENGTH_LIMIT = 9,
+	// Longest code resolved by a single DecodeTable lookup
+	HUFFMAN_DEFAULT_MAX_CODE_LENGTH = 11
+};
+
+enum
+{
+	// Bytes written by write_code_lengths, 4 bits per symbol
+	CODE_LENGTHS_SIZE = (HUFFMAN_NUM_SYMBOLS * 4 + 7) / 8
+};
+
+// Computes optimal code lengths, none longer than max_length, for the
+// HUFFMAN_NUM_SYMBOLS entries of frequency. Symbols with frequency 0 get
+// length 0. A lone symbol gets length 1.
+//
+// The counts are sorted once and Huffman's lengths found from them in
+// linear time, in place. Only if some code comes out longer than
+// max_length does it fall back to package-merge.
+void build_code_lengths(const unsigned long long* frequency, unsigned int max_length, unsigned char* lengths);
+
+// Same as build_code_lengths, but keeps the package-merge lists between
+// calls, so building codes for many blocks stops allocating once they have
+// grown. Codes that fit in max_length never allocate.
+class CodeLengthBuilder
+{
+public:
+	void build(const unsigned long long* frequency, unsigned int max_length, unsigned char* lengths);
+
+private:
+	struct Item
+	{
+		unsigned long long weight;
+		// Symbol for leaves, -1 for packages of items 2*i and 2*i+1 of the
+		// previous level, where i is this item's package index.
+		int symbol;
+		int package;
+	};
+
+	static bool lighter(const Item& a, const Item& b);
+	// Breaks ties by symbol, which makes a plain sort of the leaves stable
+	static bool lighterLeaf(const Item& a, const Item& b);
+
+	void packageMerge(unsigned int max_length, unsigned char* lengths);
+
+	// Symbols in use, by weight
+	Item leaves[HUFFMAN_NUM_SYMBOLS];
+	unsigned int leaf_count;
+	std::vector<Item> packages;
+	// levels[k] holds the leaves merged with the packages of levels[k-1]
+	std::vector<std::vector<Item> > levels;
+};
+
+// Assigns canonical codes to lengths: shorter codes come first and codes
+// of the same length are ordered by symbol.
+void canonical_codes(const unsigned char* lengths, unsigned int* codes);
+
+template <typename Writer>
+void write_code_lengths(Writer& s, const unsigned char* lengths);
+// Throws std::ios_base::failure if the lengths don't describe a complete
+// prefix code.
+template <typename Reader>
+void read_code_lengths(Reader& s, unsigned char* lengths);
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Writer>
+void write_code_lengths(Writer& s, const unsigned char* lengths)
+{
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		s.pushBits(lengths[i], 4);
+}
+
+template <typename Reader>
+void read_code_lengths(Reader& s, unsigned char* lengths)
+{
+	// Kraft sum in units of 2^-HUFFMAN_MAX_CODE_LENGTH
+	unsigned long kraft = 0;
+	unsigned int used = 0;
+
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		lengths[i] = static_cast<unsigned char>(s.peekBits(4));
+		s.skipBits(4);
+
+		if (lengths[i] != 0)
+		{
+			kraft += 1UL << (HUFFMAN_MAX_CODE_LENGTH - lengths[i]);
+			++used;
+		}
+	}
+
+	const unsigned long complete = 1UL << HUFFMAN_MAX_CODE_LENGTH;
+	if (!(kraft == complete || (used == 1 && kraft == complete / 2)))
+		throw std::ios_base::failure("invalid code lengths");
+}
+
+#endif // YURIKS_CANONICAL_H
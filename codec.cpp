@@ -0,0 +1,125 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "codec.h"
+
+#include <algorithm>
+#include <ios>
+
+size_t huffman_compress_bound(size_t size)
+{
+	size_t full_blocks = size / CODEC_MAX_BLOCK_SIZE;
+	size_t last = size % CODEC_MAX_BLOCK_SIZE;
+
+	size_t bound = full_blocks * compressed_block_bound(CODEC_MAX_BLOCK_SIZE);
+	if (last != 0)
+		bound += compressed_block_bound(last);
+	return bound;
+}
+
+size_t huffman_decompressed_size(const unsigned char* in, size_t in_size)
+{
+	size_t raw_size = 0;
+	size_t pos = 0;
+
+	while (pos < in_size)
+	{
+		if (in_size - pos < BLOCK_HEADER_SIZE)
+			throw std::ios_base::failure("unexpected end of compressed buffer");
+
+		BlockHeader header = read_block_header(in + pos);
+		if (header.data_size > in_size - pos - BLOCK_HEADER_SIZE)
+			throw std::ios_base::failure("unexpected end of compressed buffer");
+
+		raw_size += header.raw_size;
+		pos += BLOCK_HEADER_SIZE + header.data_size;
+	}
+
+	return raw_size;
+}
+
+HuffmanContext::HuffmanContext()
+{
+}
+
+HuffmanContext::HuffmanContext(const BlockOptions& options)
+	: options_(options)
+{
+}
+
+size_t HuffmanContext::compress(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size)
+{
+	if (out_size < huffman_compress_bound(in_size))
+		throw std::ios_base::failure("output buffer too small");
+
+	size_t pos = 0;
+	for (size_t i = 0; i < in_size; i += CODEC_MAX_BLOCK_SIZE)
+	{
+		size_t raw_size = std::min<size_t>(in_size - i, CODEC_MAX_BLOCK_SIZE);
+		pos += compress_block(in + i, raw_size, options_, out + pos, tables);
+	}
+
+	if (options_.stats != 0)
+	{
+		options_.stats->bytes_in += in_size;
+		options_.stats->bytes_out += pos;
+	}
+
+	return pos;
+}
+
+size_t HuffmanContext::decompress(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size)
+{
+	size_t raw_pos = 0;
+	size_t pos = 0;
+
+	while (pos < in_size)
+	{
+		if (in_size - pos < BLOCK_HEADER_SIZE)
+			throw std::ios_base::failure("unexpected end of compressed buffer");
+
+		BlockHeader header = read_block_header(in + pos);
+		pos += BLOCK_HEADER_SIZE;
+
+		// Empty blocks are never written, so they are as corrupt as BLOCK_END
+		if (header.type == BLOCK_END || header.raw_size == 0)
+			throw std::ios_base::failure("invalid block");
+		if (header.data_size > in_size - pos)
+			throw std::ios_base::failure("unexpected end of compressed buffer");
+		if (header.raw_size > out_size - raw_pos)
+			throw std::ios_base::failure("output buffer too small");
+
+		decompress_block(header, in + pos, out + raw_pos, tables, options_.stats);
+
+		pos += header.data_size;
+		raw_pos += header.raw_size;
+	}
+
+	if (options_.stats != 0)
+	{
+		options_.stats->bytes_in += in_size;
+		options_.stats->bytes_out += raw_pos;
+	}
+
+	return raw_pos;
+}
@@ -0,0 +1,90 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_CODEC_H
+#define YURIKS_CODEC_H
+
+#include "block.h"
+
+#include <cstddef>
+
+// Buffer to buffer compression, for callers that already have their data in
+// memory. The compressed buffer is just the blocks back to back, without
+// the container's header or index, so small buffers only pay for the
+// block headers. Inputs larger than CODEC_MAX_BLOCK_SIZE are split into
+// several blocks.
+
+enum
+{
+	CODEC_MAX_BLOCK_SIZE = 256 * 1024 * 1024
+};
+
+// Largest compressed size of size bytes. An output buffer this large never
+// makes compress() fail.
+size_t huffman_compress_bound(size_t size);
+
+// Reads the block headers of a compressed buffer and returns the size it
+// decompresses to.
+// Throws std::ios_base::failure if the headers are truncated or invalid.
+size_t huffman_decompressed_size(const unsigned char* in, size_t in_size);
+
+// Keeps the code tables and scratch buffers between calls. After
+// the first few calls have grown them to fit, compressing or decompressing
+// doesn't allocate any memory. One context must only be used by one thread
+// at a time; use a context per thread instead.
+class HuffmanContext
+{
+public:
+	HuffmanContext();
+	explicit HuffmanContext(const BlockOptions& options);
+
+	const BlockOptions& options() const;
+	void setOptions(const BlockOptions& options);
+
+	// Compresses in into out and returns the compressed size. Empty inputs
+	// compress to 0 bytes.
+	// Throws std::ios_base::failure if out_size is less than
+	// huffman_compress_bound(in_size).
+	size_t compress(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size);
+
+	// Decompresses in into out and returns the decompressed size.
+	// Throws std::ios_base::failure if in is corrupt or doesn't fit in
+	// out_size bytes.
+	size_t decompress(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size);
+
+private:
+	BlockOptions options_;
+	BlockTables tables;
+};
+
+inline const BlockOptions& HuffmanContext::options() const
+{
+	return options_;
+}
+
+inline void HuffmanContext::setOptions(const BlockOptions& options)
+{
+	options_ = options;
+}
+
+#endif // YURIKS_CODEC_H
@@ -0,0 +1,576 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "container.h"
+#include "block.h"
+#include "canonical.h"
+#include "huffman.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace
+{
+
+typedef std::shared_ptr<std::vector<unsigned char> > Buffer;
+
+Buffer compress_span_task(const unsigned char* raw, size_t raw_size, const BlockOptions& options)
+{
+	Buffer block(new std::vector<unsigned char>);
+	block->reserve(compressed_block_bound(raw_size));
+	compress_block(raw, raw_size, options, *block);
+	return block;
+}
+
+Buffer compress_task(Buffer raw, const BlockOptions& options)
+{
+	return compress_span_task(&(*raw)[0], raw->size(), options);
+}
+
+struct raw_offset_lt
+{
+	inline bool operator()(const ContainerIndexEntry& a, const ContainerIndexEntry& b) const
+	{
+		return a.raw_offset < b.raw_offset;
+	}
+};
+
+BlockHeader check_block(const unsigned char* block, size_t block_size, size_t raw_size)
+{
+	if (block_size < BLOCK_HEADER_SIZE)
+		throw std::ios_base::failure("invalid block index");
+
+	BlockHeader header = read_block_header(block);
+	if (header.raw_size != raw_size || header.data_size != block_size - BLOCK_HEADER_SIZE || header.raw_size == 0)
+		throw std::ios_base::failure("block doesn't match the index");
+
+	return header;
+}
+
+void decompress_task(const unsigned char* block, size_t block_size, unsigned char* raw, size_t raw_size, Stats* stats)
+{
+	BlockHeader header = check_block(block, block_size, raw_size);
+	decompress_block(header, block + BLOCK_HEADER_SIZE, raw, stats);
+}
+
+void decompress_buffer_task(const BlockHeader& header, Buffer data, Buffer raw, Stats* stats)
+{
+	decompress_block(header, &(*data)[0], &(*raw)[0], stats);
+}
+
+typedef std::deque<std::pair<Buffer, std::future<void> > > PendingRaw;
+
+// Waits for the oldest block being decoded and writes it out
+void write_front(PendingRaw& pending, std::ostream& out, unsigned long long& raw_size, Stats* stats)
+{
+	pending.front().second.get();
+
+	const std::vector<unsigned char>& raw = *pending.front().first;
+	out.write(reinterpret_cast<const char*>(&raw[0]), raw.size());
+	raw_size += raw.size();
+	pending.pop_front();
+
+	if (stats != 0)
+		stats->progress(raw_size, 0);
+}
+
+void write_index(std::ostream& out, const std::vector<ContainerIndexEntry>& index, unsigned long long offset, unsigned long long raw_size)
+{
+	std::vector<unsigned char> buf(index.size() * CONTAINER_INDEX_ENTRY_SIZE + CONTAINER_FOOTER_SIZE);
+	unsigned char* p = &buf[0];
+
+	for (size_t i = 0; i < index.size(); ++i, p += CONTAINER_INDEX_ENTRY_SIZE)
+	{
+		store_u64(p, index[i].offset);
+		store_u64(p + 8, index[i].raw_offset);
+	}
+
+	store_u64(p, raw_size);
+	store_u64(p + 8, index.size());
+	store_u64(p + 16, offset);
+	p[24] = 'H'; p[25] = 'Z'; p[26] = 'I'; p[27] = 'X';
+
+	out.write(reinterpret_cast<const char*>(&buf[0]), buf.size());
+}
+
+// Writes the container around blocks that are compressed out of order but
+// must be written in order. Keeping a couple of blocks queued per thread
+// hides the uneven block times.
+class BlockWriter
+{
+public:
+	// total is the input size for progress, 0 if unknown
+	BlockWriter(std::ostream& out, const ContainerOptions& options, unsigned int threads, unsigned long long total);
+
+	// Waits for the oldest block first if too many are queued.
+	void push(std::future<Buffer> block, size_t raw_size);
+	// Writes a block that is ready, after the queued ones.
+	void write(const std::vector<unsigned char>& block, size_t raw_size);
+	// Writes the remaining blocks, the index and the footer.
+	void finish();
+
+private:
+	void writeFront();
+	void writeBlock(const std::vector<unsigned char>& block, size_t raw_size);
+
+	std::ostream& out;
+	std::deque<std::pair<std::future<Buffer>, size_t> > pending;
+	size_t max_pending;
+	Stats* stats;
+	unsigned long long total;
+
+	std::vector<ContainerIndexEntry> index;
+	unsigned long long offset;
+	unsigned long long raw_offset;
+};
+
+BlockWriter::BlockWriter(std::ostream& out, const ContainerOptions& options, unsigned int threads, unsigned long long total)
+	: out(out), max_pending(2 * threads), stats(options.block.stats), total(total),
+	offset(CONTAINER_HEADER_SIZE), raw_offset(0)
+{
+	unsigned char header[CONTAINER_HEADER_SIZE] = { 'H', 'Z', FORMAT_BLOCKS };
+	store_u32(header + 3, static_cast<unsigned int>(options.block_size));
+	out.write(reinterpret_cast<const char*>(header), CONTAINER_HEADER_SIZE);
+}
+
+void BlockWriter::push(std::future<Buffer> block, size_t raw_size)
+{
+	pending.push_back(std::make_pair(std::move(block), raw_size));
+
+	if (pending.size() >= max_pending)
+		writeFront();
+}
+
+void BlockWriter::writeFront()
+{
+	Buffer block = pending.front().first.get();
+	size_t raw_size = pending.front().second;
+	pending.pop_front();
+
+	writeBlock(*block, raw_size);
+}
+
+void BlockWriter::write(const std::vector<unsigned char>& block, size_t raw_size)
+{
+	while (!pending.empty())
+		writeFront();
+
+	writeBlock(block, raw_size);
+}
+
+void BlockWriter::writeBlock(const std::vector<unsigned char>& block, size_t raw_size)
+{
+	ContainerIndexEntry entry = { offset, raw_offset };
+	index.push_back(entry);
+
+	out.write(reinterpret_cast<const char*>(&block[0]), block.size());
+	offset += block.size();
+	raw_offset += raw_size;
+
+	if (stats != 0)
+		stats->progress(raw_offset, total);
+}
+
+void BlockWriter::finish()
+{
+	while (!pending.empty())
+		writeFront();
+
+	unsigned char end[BLOCK_HEADER_SIZE];
+	BlockHeader end_header = { BLOCK_END, 0, 0 };
+	write_block_header(end, end_header);
+	out.write(reinterpret_cast<const char*>(end), BLOCK_HEADER_SIZE);
+	offset += BLOCK_HEADER_SIZE;
+
+	PhaseTimer timer(stats, PHASE_HEADER);
+	write_index(out, index, offset, raw_offset);
+
+	if (stats != 0)
+	{
+		stats->bytes_in += raw_offset;
+		stats->bytes_out += offset + index.size() * CONTAINER_INDEX_ENTRY_SIZE + CONTAINER_FOOTER_SIZE;
+	}
+}
+
+// Checks the footer and fills in everything but the block entries
+void parse_footer(ContainerIndex& index, const unsigned char* header, const unsigned char* footer,
+	unsigned long long file_size, unsigned long long& index_offset)
+{
+	if (footer[24] != 'H' || footer[25] != 'Z' || footer[26] != 'I' || footer[27] != 'X')
+		throw std::ios_base::failure("missing block index");
+
+	index.block_size = load_u32(header + 3);
+	index.raw_size = load_u64(footer);
+	unsigned long long count = load_u64(footer + 8);
+	index_offset = load_u64(footer + 16);
+
+	if (index_offset < CONTAINER_HEADER_SIZE + BLOCK_HEADER_SIZE || index_offset > file_size - CONTAINER_FOOTER_SIZE ||
+		count > file_size / CONTAINER_INDEX_ENTRY_SIZE ||
+		file_size - CONTAINER_FOOTER_SIZE - index_offset != count * CONTAINER_INDEX_ENTRY_SIZE)
+		throw std::ios_base::failure("invalid block index");
+
+	index.blocks.resize(static_cast<size_t>(count) + 1);
+}
+
+void parse_entries(ContainerIndex& index, const unsigned char* entries, unsigned long long index_offset)
+{
+	size_t count = index.blockCount();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		index.blocks[i].offset = load_u64(entries + i * CONTAINER_INDEX_ENTRY_SIZE);
+		index.blocks[i].raw_offset = load_u64(entries + i * CONTAINER_INDEX_ENTRY_SIZE + 8);
+	}
+	index.blocks.back().offset = index_offset - BLOCK_HEADER_SIZE;
+	index.blocks.back().raw_offset = index.raw_size;
+
+	// Sizes are checked again against each block header while decoding
+	unsigned long long prev_offset = CONTAINER_HEADER_SIZE;
+	unsigned long long prev_raw = 0;
+	for (size_t i = 0; i < index.blocks.size(); ++i)
+	{
+		const ContainerIndexEntry& e = index.blocks[i];
+
+		if (e.offset < prev_offset || e.raw_offset < prev_raw || e.raw_offset - prev_raw > index.block_size ||
+			(i == 0 && (e.offset != CONTAINER_HEADER_SIZE || e.raw_offset != 0)))
+			throw std::ios_base::failure("invalid block index");
+
+		prev_offset = e.offset;
+		prev_raw = e.raw_offset;
+	}
+}
+
+// Decodes a block into a scratch buffer and keeps only the part in range
+void decompress_partial_task(const unsigned char* block, size_t block_size, size_t raw_size,
+	size_t skip, size_t size, unsigned char* out, Stats* stats)
+{
+	std::vector<unsigned char> raw(raw_size);
+	decompress_task(block, block_size, &raw[0], raw_size, stats);
+	std::copy(raw.begin() + skip, raw.begin() + skip + size, out);
+}
+
+} // namespace
+
+ContainerOptions::ContainerOptions()
+	: block_size(CONTAINER_DEFAULT_BLOCK_SIZE), threads(0)
+{
+}
+
+void compress_blocks(std::istream& in, std::ostream& out, const ContainerOptions& options)
+{
+	ThreadPool pool(options.threads);
+	BlockWriter writer(out, options, pool.size(), 0);
+
+	while (true)
+	{
+		Buffer raw(new std::vector<unsigned char>(options.block_size));
+		in.read(reinterpret_cast<char*>(&(*raw)[0]), raw->size());
+		raw->resize(static_cast<size_t>(in.gcount()));
+
+		if (raw->empty())
+			break;
+
+		size_t raw_size = raw->size();
+		writer.push(pool.submit(std::bind(compress_task, raw, options.block)), raw_size);
+
+		if (raw_size < options.block_size)
+			break;
+	}
+
+	writer.finish();
+}
+
+void compress_blocks(const unsigned char* data, unsigned long long size, std::ostream& out, const ContainerOptions& options)
+{
+	ThreadPool pool(options.threads);
+	BlockWriter writer(out, options, pool.size(), size);
+
+	for (unsigned long long pos = 0; pos < size; pos += options.block_size)
+	{
+		size_t raw_size = static_cast<size_t>(std::min<unsigned long long>(size - pos, options.block_size));
+		writer.push(pool.submit(std::bind(compress_span_task, data + pos, raw_size, options.block)), raw_size);
+	}
+
+	writer.finish();
+}
+
+void write_blocks(std::ostream& out, size_t block_size, const std::vector<std::vector<unsigned char> >& blocks)
+{
+	ContainerOptions options;
+	options.block_size = block_size;
+	BlockWriter writer(out, options, 1, 0);
+
+	for (size_t i = 0; i < blocks.size(); ++i)
+		writer.write(blocks[i], read_block_header(&blocks[i][0]).raw_size);
+
+	writer.finish();
+}
+
+void decompress_blocks(std::istream& in, std::ostream& out, unsigned int threads, Stats* stats)
+{
+	unsigned char header[CONTAINER_HEADER_SIZE - 3];
+	if (!in.read(reinterpret_cast<char*>(header), sizeof(header)))
+		throw std::ios_base::failure("unexpected end of file");
+	unsigned int block_size = load_u32(header);
+
+	ThreadPool pool(threads);
+	const size_t max_pending = 2 * pool.size();
+	PendingRaw pending;
+	unsigned long long in_size = CONTAINER_HEADER_SIZE + BLOCK_HEADER_SIZE;
+	unsigned long long raw_size = 0;
+
+	while (true)
+	{
+		unsigned char block[BLOCK_HEADER_SIZE];
+		if (!in.read(reinterpret_cast<char*>(block), BLOCK_HEADER_SIZE))
+			throw std::ios_base::failure("unexpected end of file");
+
+		BlockHeader block_header = read_block_header(block);
+		if (block_header.type == BLOCK_END)
+			break;
+		if (block_header.raw_size == 0 || block_header.raw_size > block_size ||
+			block_header.data_size == 0 || block_header.data_size > compressed_block_bound(block_size))
+			throw std::ios_base::failure("invalid block header");
+
+		Buffer data(new std::vector<unsigned char>(block_header.data_size));
+		if (!in.read(reinterpret_cast<char*>(&(*data)[0]), data->size()))
+			throw std::ios_base::failure("unexpected end of file");
+
+		Buffer raw(new std::vector<unsigned char>(block_header.raw_size));
+		pending.push_back(std::make_pair(raw, pool.submit(std::bind(decompress_buffer_task, block_header, data, raw, stats))));
+		in_size += BLOCK_HEADER_SIZE + data->size();
+
+		if (pending.size() >= max_pending)
+			write_front(pending, out, raw_size, stats);
+	}
+
+	while (!pending.empty())
+		write_front(pending, out, raw_size, stats);
+
+	if (stats != 0)
+	{
+		stats->bytes_in += in_size;
+		stats->bytes_out += raw_size;
+	}
+}
+
+size_t ContainerIndex::findBlock(unsigned long long raw_offset) const
+{
+	ContainerIndexEntry key = { 0, raw_offset };
+	std::vector<ContainerIndexEntry>::const_iterator i = std::upper_bound(blocks.begin(), blocks.end(), key, raw_offset_lt());
+	return (i - blocks.begin()) - 1;
+}
+
+ContainerIndex read_container_index(std::istream& in)
+{
+	unsigned char header[CONTAINER_HEADER_SIZE];
+	unsigned char footer[CONTAINER_FOOTER_SIZE];
+
+	in.seekg(0, std::ios::end);
+	unsigned long long file_size = in.tellg();
+
+	if (file_size < CONTAINER_HEADER_SIZE + BLOCK_HEADER_SIZE + CONTAINER_FOOTER_SIZE)
+		throw std::ios_base::failure("file too short for a block index");
+
+	in.seekg(0);
+	in.read(reinterpret_cast<char*>(header), CONTAINER_HEADER_SIZE);
+	in.seekg(file_size - CONTAINER_FOOTER_SIZE);
+	in.read(reinterpret_cast<char*>(footer), CONTAINER_FOOTER_SIZE);
+	if (!in)
+		throw std::ios_base::failure("missing block index");
+
+	ContainerIndex index;
+	unsigned long long index_offset;
+	parse_footer(index, header, footer, file_size, index_offset);
+
+	std::vector<unsigned char> entries(index.blockCount() * CONTAINER_INDEX_ENTRY_SIZE + 1);
+	in.seekg(index_offset);
+	in.read(reinterpret_cast<char*>(&entries[0]), entries.size() - 1);
+	if (!in)
+		throw std::ios_base::failure("invalid block index");
+
+	parse_entries(index, &entries[0], index_offset);
+	return index;
+}
+
+ContainerIndex read_container_index(const unsigned char* data, unsigned long long size)
+{
+	if (size < CONTAINER_HEADER_SIZE + BLOCK_HEADER_SIZE + CONTAINER_FOOTER_SIZE)
+		throw std::ios_base::failure("file too short for a block index");
+
+	ContainerIndex index;
+	unsigned long long index_offset;
+	parse_footer(index, data, data + size - CONTAINER_FOOTER_SIZE, size, index_offset);
+	parse_entries(index, data + index_offset, index_offset);
+	return index;
+}
+
+void decompress_range(std::istream& in, std::ostream& out, const ContainerIndex& index,
+	unsigned long long offset, unsigned long long length, unsigned int threads, Stats* stats)
+{
+	if (offset >= index.raw_size || length == 0)
+		return;
+	if (length > index.raw_size - offset)
+		length = index.raw_size - offset;
+
+	const size_t first = index.findBlock(offset);
+	const size_t last = index.findBlock(offset + length - 1) + 1;
+
+	// Progress is measured in the blocks' raw bytes
+	const unsigned long long first_raw = index.blocks[first].raw_offset;
+	const unsigned long long total_raw = index.blocks[last].raw_offset - first_raw;
+
+	std::vector<unsigned char> data;
+	std::vector<unsigned char> window;
+
+	// Destroyed before the buffers, so running tasks finish first if a
+	// block fails
+	ThreadPool pool(threads);
+	const size_t batch = 2 * pool.size();
+	std::vector<std::future<void> > pending;
+
+	for (size_t begin = first; begin < last; begin += batch)
+	{
+		const size_t end = std::min(last, begin + batch);
+
+		// The blocks of a batch are contiguous in both the file and the output
+		const ContainerIndexEntry& from = index.blocks[begin];
+		const ContainerIndexEntry& to = index.blocks[end];
+
+		data.resize(static_cast<size_t>(to.offset - from.offset));
+		window.resize(static_cast<size_t>(to.raw_offset - from.raw_offset));
+
+		in.seekg(from.offset);
+		if (!in.read(reinterpret_cast<char*>(&data[0]), data.size()))
+			throw std::ios_base::failure("unexpected end of file");
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			const unsigned char* block = &data[static_cast<size_t>(index.blocks[i].offset - from.offset)];
+			unsigned char* raw = &window[static_cast<size_t>(index.blocks[i].raw_offset - from.raw_offset)];
+			size_t block_size = static_cast<size_t>(index.blocks[i+1].offset - index.blocks[i].offset);
+			size_t raw_size = static_cast<size_t>(index.blocks[i+1].raw_offset - index.blocks[i].raw_offset);
+
+			pending.push_back(pool.submit(std::bind(decompress_task, block, block_size, raw, raw_size, stats)));
+		}
+
+		for (size_t i = 0; i < pending.size(); ++i)
+			pending[i].get();
+		pending.clear();
+
+		// Trim the parts of the first and last blocks outside the range
+		size_t skip = 0;
+		size_t size = window.size();
+		if (from.raw_offset < offset)
+			skip = static_cast<size_t>(offset - from.raw_offset);
+		if (to.raw_offset > offset + length)
+			size = static_cast<size_t>(offset + length - from.raw_offset);
+
+		out.write(reinterpret_cast<const char*>(&window[skip]), size - skip);
+
+		if (stats != 0)
+		{
+			stats->bytes_in += data.size();
+			stats->bytes_out += size - skip;
+			stats->progress(to.raw_offset - first_raw, total_raw);
+		}
+	}
+}
+
+void decompress_block_span(const unsigned char* data, const ContainerIndex& index,
+	size_t first, size_t last, unsigned char* out, BlockTables& tables, Stats* stats)
+{
+	for (size_t i = first; i < last; ++i)
+	{
+		const ContainerIndexEntry& from = index.blocks[i];
+		const ContainerIndexEntry& to = index.blocks[i+1];
+
+		const unsigned char* block = data + from.offset;
+		BlockHeader header = check_block(block, static_cast<size_t>(to.offset - from.offset),
+			static_cast<size_t>(to.raw_offset - from.raw_offset));
+		decompress_block(header, block + BLOCK_HEADER_SIZE, out + (from.raw_offset - index.blocks[first].raw_offset), tables, stats);
+	}
+}
+
+void decompress_range(const unsigned char* data, const ContainerIndex& index,
+	unsigned long long offset, unsigned long long length, unsigned char* out, unsigned int threads, Stats* stats)
+{
+	if (offset >= index.raw_size || length == 0)
+		return;
+	if (length > index.raw_size - offset)
+		length = index.raw_size - offset;
+
+	const unsigned long long end = offset + length;
+	const size_t first = index.findBlock(offset);
+	const size_t last = index.findBlock(end - 1) + 1;
+
+	ThreadPool pool(threads);
+	std::vector<std::future<void> > pending;
+	pending.reserve(last - first);
+
+	for (size_t i = first; i < last; ++i)
+	{
+		const ContainerIndexEntry& from = index.blocks[i];
+		const ContainerIndexEntry& to = index.blocks[i+1];
+
+		const unsigned char* block = data + from.offset;
+		size_t block_size = static_cast<size_t>(to.offset - from.offset);
+		size_t raw_size = static_cast<size_t>(to.raw_offset - from.raw_offset);
+
+		if (from.raw_offset >= offset && to.raw_offset <= end)
+		{
+			// Whole block in range, decode in place
+			unsigned char* raw = out + (from.raw_offset - offset);
+			pending.push_back(pool.submit(std::bind(decompress_task, block, block_size, raw, raw_size, stats)));
+		}
+		else
+		{
+			unsigned long long from_raw = std::max(from.raw_offset, offset);
+			unsigned long long to_raw = std::min(to.raw_offset, end);
+
+			pending.push_back(pool.submit(std::bind(decompress_partial_task, block, block_size, raw_size,
+				static_cast<size_t>(from_raw - from.raw_offset), static_cast<size_t>(to_raw - from_raw), out + (from_raw - offset), stats)));
+		}
+	}
+
+	const unsigned long long first_raw = index.blocks[first].raw_offset;
+	const unsigned long long total_raw = index.blocks[last].raw_offset - first_raw;
+
+	for (size_t i = 0; i < pending.size(); ++i)
+	{
+		pending[i].get();
+
+		if (stats != 0)
+			stats->progress(index.blocks[first + i + 1].raw_offset - first_raw, total_raw);
+	}
+
+	if (stats != 0)
+	{
+		stats->bytes_in += index.blocks[last].offset - index.blocks[first].offset;
+		stats->bytes_out += length;
+	}
+}
@@ -0,0 +1,128 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_CONTAINER_H
+#define YURIKS_CONTAINER_H
+
+#include "block.h"
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+// Layout of a FORMAT_BLOCKS file, all integers little-endian:
+//
+//   "HZ" FORMAT_BLOCKS, u32 block size
+//   blocks, each with at most block size raw bytes
+//   a BLOCK_END block
+//   index: for every block, u64 file offset and u64 raw offset
+//   footer: u64 raw size, u64 block count, u64 index offset, "HZIX"
+//
+// Blocks are self-contained, so they can be coded independently.
+
+enum
+{
+	CONTAINER_HEADER_SIZE = 7,
+	CONTAINER_INDEX_ENTRY_SIZE = 16,
+	CONTAINER_FOOTER_SIZE = 28,
+
+	CONTAINER_MIN_BLOCK_SIZE = 1024,
+	CONTAINER_MAX_BLOCK_SIZE = 256 * 1024 * 1024,
+	CONTAINER_DEFAULT_BLOCK_SIZE = 1024 * 1024
+};
+
+struct ContainerOptions
+{
+	ContainerOptions();
+
+	size_t block_size;
+	// block.stats also gets the container's progress and byte counts
+	BlockOptions block;
+	// 0 means one per hardware thread
+	unsigned int threads;
+};
+
+struct ContainerIndexEntry
+{
+	unsigned long long offset;
+	unsigned long long raw_offset;
+};
+
+struct ContainerIndex
+{
+	unsigned int block_size;
+	unsigned long long raw_size;
+	// Followed by a sentinel entry at the BLOCK_END block and raw_size, so
+	// block i spans [blocks[i], blocks[i+1]).
+	std::vector<ContainerIndexEntry> blocks;
+
+	size_t blockCount() const;
+	// Block containing raw byte raw_offset, which must be < raw_size.
+	size_t findBlock(unsigned long long raw_offset) const;
+};
+
+inline size_t ContainerIndex::blockCount() const
+{
+	return blocks.size() - 1;
+}
+
+// Reads and compresses one block at a time, so `in` can be a pipe and
+// memory use only depends on the block size and thread count.
+void compress_blocks(std::istream& in, std::ostream& out, const ContainerOptions& options);
+// Compresses a buffer that is already in memory, such as a mapped file,
+// without copying it.
+void compress_blocks(const unsigned char* data, unsigned long long size, std::ostream& out, const ContainerOptions& options);
+
+// Writes a whole FORMAT_BLOCKS file around blocks made by compress_block,
+// in order, for callers that schedule the blocks themselves.
+void write_blocks(std::ostream& out, size_t block_size, const std::vector<std::vector<unsigned char> >& blocks);
+
+// Decodes the blocks in a single pass without the index, so it works on
+// pipes. Up to two blocks per worker are in flight, so memory use only
+// depends on the block size. Expects the format header to have been
+// consumed by read_format already.
+// Throws std::ios_base::failure on corrupt input.
+void decompress_blocks(std::istream& in, std::ostream& out, unsigned int threads, Stats* stats = 0);
+
+// Reads the header and index of a FORMAT_BLOCKS file. `in` must be seekable.
+// Throws std::ios_base::failure if they are missing or inconsistent.
+ContainerIndex read_container_index(std::istream& in);
+ContainerIndex read_container_index(const unsigned char* data, unsigned long long size);
+
+// Decodes the raw bytes [offset, offset+length) to out, only reading the
+// blocks that cover them. Blocks are decoded concurrently by `threads`
+// workers (0 for one per hardware thread) into a preallocated window that
+// is written out in order.
+void decompress_range(std::istream& in, std::ostream& out, const ContainerIndex& index,
+	unsigned long long offset, unsigned long long length, unsigned int threads, Stats* stats = 0);
+// Same for a whole compressed file in memory, decoding straight into out,
+// which must have room for the (clamped) length bytes.
+void decompress_range(const unsigned char* data, const ContainerIndex& index,
+	unsigned long long offset, unsigned long long length, unsigned char* out, unsigned int threads, Stats* stats = 0);
+
+// Decodes blocks [first, last) of a compressed file in memory on the calling
+// thread, into out, which starts at the raw offset of block first.
+void decompress_block_span(const unsigned char* data, const ContainerIndex& index,
+	size_t first, size_t last, unsigned char* out, BlockTables& tables, Stats* stats = 0);
+
+#endif // YURIKS_CONTAINER_H
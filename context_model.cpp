@@ -0,0 +1,336 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "context_model.h"
+#include "bitstream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ios>
+
+namespace
+{
+
+enum
+{
+	// Regrouping rounds, it rarely changes much after a few
+	CLUSTER_ROUNDS = 4
+};
+
+struct heavier
+{
+	const unsigned long long* total;
+
+	inline bool operator()(unsigned int a, unsigned int b) const
+	{
+		return total[a] > total[b] || (total[a] == total[b] && a < b);
+	}
+};
+
+size_t header_size(unsigned int groups)
+{
+	return (8 + CONTEXT_COUNT * 4 + groups * HUFFMAN_NUM_SYMBOLS * 4 + 7) / 8;
+}
+
+} // namespace
+
+size_t ContextModel::build(const unsigned char* data, size_t size, unsigned int max_groups, unsigned int max_code_length,
+	CodeLengthBuilder& builder)
+{
+	pair_counts.assign(CONTEXT_COUNT * 256, 0);
+
+	unsigned int prev = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		++pair_counts[(prev << 8) | data[i]];
+		prev = data[i];
+	}
+
+	pairs.clear();
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+	{
+		pairs_begin[c] = pairs.size();
+		context_total[c] = 0;
+
+		for (unsigned int b = 0; b < 256; ++b)
+		{
+			unsigned int count = pair_counts[(c << 8) | b];
+			if (count != 0)
+			{
+				Pair pair = { b, count };
+				pairs.push_back(pair);
+				context_total[c] += count;
+			}
+		}
+	}
+	pairs_begin[CONTEXT_COUNT] = pairs.size();
+
+	max_groups = std::min<unsigned int>(max_groups, CONTEXT_MAX_GROUPS);
+
+	size_t best_size = ~size_t(0);
+	group_count = 0;
+
+	unsigned char try_group_of[CONTEXT_COUNT];
+	unsigned char try_lengths[CONTEXT_MAX_GROUPS][HUFFMAN_NUM_SYMBOLS];
+
+	// More groups fit the data better but cost a code each in the header
+	for (unsigned int k = 2; ; k *= 2)
+	{
+		unsigned int requested = std::min(k, max_groups);
+		unsigned int groups = requested; // Lowered if some groups end up empty
+
+		size_t try_size = cluster(groups, max_code_length, builder, try_group_of, try_lengths);
+		if (try_size < best_size)
+		{
+			best_size = try_size;
+			group_count = groups;
+			std::memcpy(group_of, try_group_of, sizeof(group_of));
+			std::memcpy(lengths, try_lengths, sizeof(lengths));
+		}
+
+		if (requested == max_groups)
+			break;
+	}
+
+	return best_size;
+}
+
+void ContextModel::sumGroups(unsigned int k, const unsigned char* assignment)
+{
+	group_counts.assign(k * HUFFMAN_NUM_SYMBOLS, 0);
+
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+	{
+		if (assignment[c] >= k)
+			continue;
+
+		unsigned long long* counts = &group_counts[assignment[c] * HUFFMAN_NUM_SYMBOLS];
+		for (size_t i = pairs_begin[c]; i < pairs_begin[c+1]; ++i)
+			counts[pairs[i].byte] += pairs[i].count;
+	}
+}
+
+// k-means over the previous bytes: start from the k most common ones, then
+// move every previous byte to the group whose statistics code its bytes in
+// the fewest bits. k is lowered to the number of groups left in the end.
+size_t ContextModel::cluster(unsigned int& k, unsigned int max_code_length, CodeLengthBuilder& builder,
+	unsigned char* assignment, unsigned char (*assigned_lengths)[HUFFMAN_NUM_SYMBOLS])
+{
+	unsigned int order[CONTEXT_COUNT];
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+		order[c] = c;
+	heavier cmp = { context_total };
+	std::sort(order, order + CONTEXT_COUNT, cmp);
+
+	unsigned int used = 0;
+	while (used < CONTEXT_COUNT && context_total[order[used]] != 0)
+		++used;
+	k = std::max(1u, std::min(k, used));
+
+	// Only the seeds are in a group at first
+	std::memset(assignment, 0xFF, CONTEXT_COUNT);
+	for (unsigned int g = 0; g < k; ++g)
+		assignment[order[g]] = static_cast<unsigned char>(g);
+	sumGroups(k, assignment);
+
+	for (int round = 0; round < CLUSTER_ROUNDS; ++round)
+	{
+		// Estimated bits per byte in each group. Bytes a group hasn't seen
+		// yet are expensive rather than impossible.
+		float bits[CONTEXT_MAX_GROUPS][256];
+		for (unsigned int g = 0; g < k; ++g)
+		{
+			const unsigned long long* counts = &group_counts[g * HUFFMAN_NUM_SYMBOLS];
+
+			unsigned long long total = 0;
+			for (unsigned int b = 0; b < 256; ++b)
+				total += counts[b];
+
+			float log_total = std::log2(static_cast<float>(total) + 128.0f);
+			for (unsigned int b = 0; b < 256; ++b)
+				bits[g][b] = log_total - std::log2(static_cast<float>(counts[b]) + 0.5f);
+		}
+
+		bool changed = false;
+		for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+		{
+			if (context_total[c] == 0)
+				continue;
+
+			unsigned int best = 0;
+			float best_cost = 0;
+			for (unsigned int g = 0; g < k; ++g)
+			{
+				float cost = 0;
+				for (size_t i = pairs_begin[c]; i < pairs_begin[c+1]; ++i)
+					cost += pairs[i].count * bits[g][pairs[i].byte];
+
+				if (g == 0 || cost < best_cost)
+				{
+					best = g;
+					best_cost = cost;
+				}
+			}
+
+			if (assignment[c] != best)
+			{
+				assignment[c] = static_cast<unsigned char>(best);
+				changed = true;
+			}
+		}
+
+		sumGroups(k, assignment);
+		if (!changed)
+			break;
+	}
+
+	// Drop groups that lost all their members
+	unsigned char renumber[CONTEXT_MAX_GROUPS];
+	unsigned int groups = 0;
+	for (unsigned int g = 0; g < k; ++g)
+	{
+		unsigned long long total = 0;
+		for (unsigned int b = 0; b < 256; ++b)
+			total += group_counts[g * HUFFMAN_NUM_SYMBOLS + b];
+
+		renumber[g] = static_cast<unsigned char>(groups);
+		if (total != 0)
+			++groups;
+	}
+
+	// Unused previous bytes can go anywhere, they never pick a code
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+		assignment[c] = context_total[c] != 0 ? renumber[assignment[c]] : 0;
+	k = groups;
+	sumGroups(k, assignment);
+
+	unsigned long long total_bits = 0;
+	for (unsigned int g = 0; g < k; ++g)
+	{
+		const unsigned long long* counts = &group_counts[g * HUFFMAN_NUM_SYMBOLS];
+		builder.build(counts, max_code_length, assigned_lengths[g]);
+
+		for (unsigned int b = 0; b < 256; ++b)
+			total_bits += counts[b] * assigned_lengths[g][b];
+	}
+
+	return header_size(k) + static_cast<size_t>((total_bits + 7) / 8);
+}
+
+size_t ContextModel::headerSize() const
+{
+	return header_size(group_count);
+}
+
+size_t ContextModel::writeHeader(unsigned char* out) const
+{
+	OMemoryBitstream stream(out);
+
+	stream.pushBits(group_count, 8);
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+		stream.pushBits(group_of[c], 4);
+	for (unsigned int g = 0; g < group_count; ++g)
+		write_code_lengths(stream, lengths[g]);
+
+	return stream.finish();
+}
+
+size_t ContextModel::readHeader(const unsigned char* data, size_t size)
+{
+	if (size < 1)
+		throw std::ios_base::failure("unexpected end of compressed block");
+
+	group_count = data[0];
+	if (group_count < 1 || group_count > CONTEXT_MAX_GROUPS)
+		throw std::ios_base::failure("invalid context group count");
+	if (size < header_size(group_count))
+		throw std::ios_base::failure("unexpected end of compressed block");
+
+	IMemoryBitstream stream(data, header_size(group_count));
+	stream.nextChar(); // Group count
+
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+	{
+		group_of[c] = static_cast<unsigned char>(stream.peekBits(4));
+		stream.skipBits(4);
+
+		if (group_of[c] >= group_count)
+			throw std::ios_base::failure("invalid context group");
+	}
+
+	if (decode_tables.size() < group_count)
+		decode_tables.resize(group_count);
+
+	for (unsigned int g = 0; g < group_count; ++g)
+	{
+		read_code_lengths(stream, lengths[g]);
+		decode_tables[g].build(lengths[g]);
+	}
+
+	return header_size(group_count);
+}
+
+size_t ContextModel::encode(const unsigned char* data, size_t size, unsigned char* out)
+{
+	if (encode_tables.size() < group_count)
+		encode_tables.resize(group_count);
+	for (unsigned int g = 0; g < group_count; ++g)
+		encode_tables[g].build(lengths[g]);
+
+	const EncodeTable* tables[CONTEXT_COUNT];
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+		tables[c] = &encode_tables[group_of[c]];
+
+	OMemoryBitstream stream(out);
+
+	unsigned int prev = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		tables[prev]->encode(stream, data[i]);
+		prev = data[i];
+	}
+
+	return stream.finish();
+}
+
+unsigned int ContextModel::decode(const unsigned char* data, size_t size, size_t raw_size, unsigned char* out)
+{
+	const DecodeTable* tables[CONTEXT_COUNT];
+	for (unsigned int c = 0; c < CONTEXT_COUNT; ++c)
+		tables[c] = &decode_tables[group_of[c]];
+
+	IMemoryBitstream stream(data, size);
+
+	unsigned int symbols = 0;
+	unsigned int prev = 0;
+	for (size_t i = 0; i < raw_size; ++i)
+	{
+		unsigned int val = tables[prev]->decode(stream);
+		symbols |= val;
+		out[i] = static_cast<unsigned char>(val);
+		prev = val & 0xFF;
+	}
+
+	return symbols;
+}
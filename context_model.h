@@ -0,0 +1,104 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_CONTEXT_MODEL_H
+#define YURIKS_CONTEXT_MODEL_H
+
+#include "canonical.h"
+#include "decode_table.h"
+#include "encode_table.h"
+
+#include <cstddef>
+#include <vector>
+
+// Order-1 model for blocks: every byte is coded with one of several codes,
+// picked by the byte before it (0 for the first byte). Previous bytes with
+// similar statistics share a group and its code, so the header only has a
+// code per group and a group number per previous byte.
+//
+// Header, as one bit stream: u8 group count, 4-bit group of each of the 256
+// previous bytes, then the code lengths of every group as written by
+// write_code_lengths. A single coded stream follows.
+
+enum
+{
+	CONTEXT_MAX_GROUPS = 16,
+	CONTEXT_COUNT = 256
+};
+
+class ContextModel
+{
+public:
+	// Counts the byte pairs in data and groups the previous bytes into at
+	// most max_groups groups, trying a few group counts. Returns the size
+	// the block data would take with the best of them, header included.
+	// data must not be empty.
+	size_t build(const unsigned char* data, size_t size, unsigned int max_groups, unsigned int max_code_length,
+		CodeLengthBuilder& builder);
+
+	unsigned int groups() const;
+
+	size_t headerSize() const;
+	// Returns the number of bytes written, headerSize().
+	size_t writeHeader(unsigned char* out) const;
+	// Returns the number of bytes read.
+	// Throws std::ios_base::failure if the header is truncated or invalid.
+	size_t readHeader(const unsigned char* data, size_t size);
+
+	// Codes data with the model from build() and returns the stream size.
+	size_t encode(const unsigned char* data, size_t size, unsigned char* out);
+	// Decodes raw_size bytes with the model from readHeader(). Returns the
+	// OR of the decoded symbols, which is past 0xFF if the data was corrupt.
+	unsigned int decode(const unsigned char* data, size_t size, size_t raw_size, unsigned char* out);
+
+private:
+	struct Pair
+	{
+		unsigned int byte;
+		unsigned int count;
+	};
+
+	size_t cluster(unsigned int& k, unsigned int max_code_length, CodeLengthBuilder& builder,
+		unsigned char* assignment, unsigned char (*assigned_lengths)[HUFFMAN_NUM_SYMBOLS]);
+	void sumGroups(unsigned int k, const unsigned char* assignment);
+
+	unsigned int group_count;
+	unsigned char group_of[CONTEXT_COUNT];
+	unsigned char lengths[CONTEXT_MAX_GROUPS][HUFFMAN_NUM_SYMBOLS];
+
+	// Scratch kept between blocks
+	std::vector<unsigned int> pair_counts;    // [previous * 256 + byte]
+	std::vector<Pair> pairs;                  // Non-zero pair_counts by previous byte
+	std::vector<unsigned long long> group_counts; // [group * HUFFMAN_NUM_SYMBOLS + symbol]
+	std::vector<EncodeTable> encode_tables;
+	std::vector<DecodeTable> decode_tables;
+	size_t pairs_begin[CONTEXT_COUNT + 1];
+	unsigned long long context_total[CONTEXT_COUNT];
+};
+
+inline unsigned int ContextModel::groups() const
+{
+	return group_count;
+}
+
+#endif // YURIKS_CONTEXT_MODEL_H
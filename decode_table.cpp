@@ -0,0 +1,166 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "decode_table.h"
+#include "canonical.h"
+
+#include <algorithm>
+
+namespace
+{
+
+int tree_depth(const HuffmanTree& tree, unsigned short node)
+{
+	const DictEntry& e = tree[node];
+	if (e.type != DICT_NODE)
+		return 0;
+
+	return 1 + std::max(tree_depth(tree, e.l), tree_depth(tree, e.r));
+}
+
+} // namespace
+
+const int DecodeTable::max_root_bits;
+const int DecodeTable::max_sub_bits;
+
+DecodeTable::DecodeTable()
+	: root_bits(0)
+{
+}
+
+DecodeTable::DecodeTable(const HuffmanTree& tree)
+{
+	root_bits = std::min(tree_depth(tree, tree.root()), max_root_bits);
+	buildLevel(tree, tree.root(), root_bits);
+}
+
+DecodeTable::DecodeTable(const unsigned char* lengths)
+{
+	build(lengths);
+}
+
+void DecodeTable::build(const unsigned char* lengths)
+{
+	unsigned int codes[HUFFMAN_NUM_SYMBOLS];
+	canonical_codes(lengths, codes);
+
+	int max_length = 0;
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		max_length = std::max(max_length, static_cast<int>(lengths[i]));
+
+	root_bits = std::min(max_length, max_root_bits);
+
+	DecodeEntry invalid = { HUFFMAN_NUM_SYMBOLS, 0, 0 };
+	entries.assign(size_t(1) << root_bits, invalid);
+
+	// Longest code under each root slot, to size the sub-tables
+	int sub_length[1 << max_root_bits] = { 0 };
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		if (lengths[i] > root_bits)
+		{
+			unsigned int prefix = codes[i] >> (lengths[i] - root_bits);
+			sub_length[prefix] = std::max(sub_length[prefix], lengths[i] - root_bits);
+		}
+	}
+
+	for (size_t prefix = 0; prefix < (size_t(1) << root_bits); ++prefix)
+	{
+		if (sub_length[prefix] != 0)
+		{
+			DecodeEntry link = { static_cast<unsigned int>(entries.size()),
+				static_cast<unsigned char>(root_bits), static_cast<unsigned char>(sub_length[prefix]) };
+			entries[prefix] = link;
+			entries.resize(entries.size() + (size_t(1) << sub_length[prefix]), invalid);
+		}
+	}
+
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		int length = lengths[i];
+		if (length == 0)
+			continue;
+
+		size_t start = 0;
+		int bits = root_bits;
+		unsigned int code = codes[i];
+
+		if (length > root_bits)
+		{
+			const DecodeEntry& link = entries[code >> (length - root_bits)];
+			start = link.value;
+			bits = link.sub_bits;
+			length -= root_bits;
+			code &= (1u << length) - 1;
+		}
+
+		DecodeEntry e = { i, static_cast<unsigned char>(length), 0 };
+		int free_bits = bits - length;
+		std::fill_n(entries.begin() + (start + (code << free_bits)), size_t(1) << free_bits, e);
+	}
+}
+
+size_t DecodeTable::buildLevel(const HuffmanTree& tree, unsigned short root, int bits)
+{
+	size_t start = entries.size();
+	entries.resize(start + (size_t(1) << bits));
+
+	fill(tree, root, 0, 0, start, bits);
+
+	return start;
+}
+
+void DecodeTable::fill(const HuffmanTree& tree, unsigned short node, int depth, unsigned int code, size_t start, int bits)
+{
+	const DictEntry& dict = tree[node];
+
+	if (dict.type == DICT_NODE && depth < bits)
+	{
+		fill(tree, dict.l, depth+1, code << 1, start, bits);
+		fill(tree, dict.r, depth+1, (code << 1) | 1, start, bits);
+	}
+	else if (dict.type == DICT_NODE)
+	{
+		// Code continues past this level, link to a sub-table
+		int sub_bits = std::min(tree_depth(tree, node), max_sub_bits);
+		size_t sub_start = buildLevel(tree, node, sub_bits);
+
+		DecodeEntry& e = entries[start + code];
+		e.value = static_cast<unsigned int>(sub_start);
+		e.length = static_cast<unsigned char>(bits);
+		e.sub_bits = static_cast<unsigned char>(sub_bits);
+	}
+	else
+	{
+		DecodeEntry e;
+		e.value = HUFFMAN_EOF;
+		if (dict.type == DICT_VALUE)
+			e.value = dict.val;
+		e.length = static_cast<unsigned char>(depth);
+		e.sub_bits = 0;
+
+		// Every index that starts with this code resolves to it
+		int free_bits = bits - depth;
+		std::fill_n(entries.begin() + (start + (code << free_bits)), size_t(1) << free_bits, e);
+	}
+}
@@ -0,0 +1,104 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_DECODE_TABLE_H
+#define YURIKS_DECODE_TABLE_H
+
+#include "dictionary.h"
+
+#include <cstddef>
+#include <vector>
+
+// One slot of a DecodeTable. A slot either resolves a symbol, consuming
+// `length` bits, or links to a sub-table that is indexed by the following
+// `sub_bits` bits, after consuming all bits of the current level.
+struct DecodeEntry
+{
+	// Symbol (HUFFMAN_EOF for EOF) or sub-table offset. Slots not covered by
+	// an incomplete code hold HUFFMAN_NUM_SYMBOLS.
+	unsigned int value;
+	unsigned char length;
+	unsigned char sub_bits; // 0 for symbols
+};
+
+// Multi-level lookup table decoder. The root table is indexed by the next
+// root_bits bits of input and resolves every code up to that length in a
+// single lookup. Longer codes chain into smaller sub-tables, so arbitrarily
+// deep trees are still supported.
+class DecodeTable
+{
+public:
+	static const int max_root_bits = 11;
+	static const int max_sub_bits = 8;
+
+	// Empty table, build() must be called before decoding.
+	DecodeTable();
+	explicit DecodeTable(const HuffmanTree& tree);
+	// Builds the table for the canonical code with these code lengths.
+	explicit DecodeTable(const unsigned char* lengths);
+
+	// Rebuilds the table in place for another canonical code, reusing the
+	// memory of the previous one.
+	void build(const unsigned char* lengths);
+
+	template <typename Reader>
+	unsigned int decode(Reader& stream) const;
+
+	// The table as built, root level first, to write it out as source
+	int rootBits() const;
+	const std::vector<DecodeEntry>& entryData() const;
+
+private:
+	size_t buildLevel(const HuffmanTree& tree, unsigned short root, int bits);
+	void fill(const HuffmanTree& tree, unsigned short node, int depth, unsigned int code, size_t start, int bits);
+
+	std::vector<DecodeEntry> entries;
+	int root_bits;
+};
+
+inline int DecodeTable::rootBits() const
+{
+	return root_bits;
+}
+
+inline const std::vector<DecodeEntry>& DecodeTable::entryData() const
+{
+	return entries;
+}
+
+template <typename Reader>
+inline unsigned int DecodeTable::decode(Reader& stream) const
+{
+	const DecodeEntry* e = &entries[stream.peekBits(root_bits)];
+
+	while (e->sub_bits != 0)
+	{
+		stream.skipBits(e->length);
+		e = &entries[e->value + stream.peekBits(e->sub_bits)];
+	}
+
+	stream.skipBits(e->length);
+	return e->value;
+}
+
+#endif // YURIKS_DECODE_TABLE_H
@@ -0,0 +1,152 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_DICTIONARY_H
+#define YURIKS_DICTIONARY_H
+
+#include <ios>
+#include <limits>
+
+enum HuffmanSymbol
+{
+	HUFFMAN_EOF = std::numeric_limits<unsigned char>::max() + 1,
+	HUFFMAN_NUM_SYMBOLS
+};
+
+enum DictType
+{
+	DICT_NONE_EOF,
+	DICT_VALUE,
+	DICT_NODE
+};
+
+struct DictEntry
+{
+	unsigned char type; // DictType
+	unsigned char val;  // DICT_VALUE only
+	unsigned short l, r; // DICT_NODE only, indices of the children
+};
+
+// Huffman tree stored as a flat array of nodes, so building or reading one
+// doesn't allocate and walking it doesn't chase pointers across the heap.
+// A tree over HUFFMAN_NUM_SYMBOLS leaves never needs more than MAX_NODES
+// nodes.
+class HuffmanTree
+{
+public:
+	static const unsigned int MAX_NODES = 2 * HUFFMAN_NUM_SYMBOLS - 1;
+
+	HuffmanTree();
+
+	// Each returns the index of the new node. Throws std::ios_base::failure
+	// if the tree is full, which only happens when reading a corrupt one.
+	unsigned short addValue(unsigned char val);
+	unsigned short addEof();
+	// Children can be set later, for trees built from the top down
+	unsigned short addNode(unsigned short l = 0, unsigned short r = 0);
+
+	void clear();
+
+	unsigned short root() const;
+	void setRoot(unsigned short node);
+	unsigned int size() const;
+
+	DictEntry& operator[](unsigned short node);
+	const DictEntry& operator[](unsigned short node) const;
+
+private:
+	unsigned short add(DictType type, unsigned char val, unsigned short l, unsigned short r);
+
+	DictEntry nodes[MAX_NODES];
+	unsigned short count;
+	unsigned short root_node;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline HuffmanTree::HuffmanTree()
+	: count(0), root_node(0)
+{
+}
+
+inline unsigned short HuffmanTree::add(DictType type, unsigned char val, unsigned short l, unsigned short r)
+{
+	if (count == MAX_NODES)
+		throw std::ios_base::failure("invalid tree");
+
+	DictEntry& e = nodes[count];
+	e.type = static_cast<unsigned char>(type);
+	e.val = val;
+	e.l = l;
+	e.r = r;
+
+	return count++;
+}
+
+inline unsigned short HuffmanTree::addValue(unsigned char val)
+{
+	return add(DICT_VALUE, val, 0, 0);
+}
+
+inline unsigned short HuffmanTree::addEof()
+{
+	return add(DICT_NONE_EOF, 0, 0, 0);
+}
+
+inline unsigned short HuffmanTree::addNode(unsigned short l, unsigned short r)
+{
+	return add(DICT_NODE, 0, l, r);
+}
+
+inline void HuffmanTree::clear()
+{
+	count = 0;
+	root_node = 0;
+}
+
+inline unsigned short HuffmanTree::root() const
+{
+	return root_node;
+}
+
+inline void HuffmanTree::setRoot(unsigned short node)
+{
+	root_node = node;
+}
+
+inline unsigned int HuffmanTree::size() const
+{
+	return count;
+}
+
+inline DictEntry& HuffmanTree::operator[](unsigned short node)
+{
+	return nodes[node];
+}
+
+inline const DictEntry& HuffmanTree::operator[](unsigned short node) const
+{
+	return nodes[node];
+}
+
+#endif // YURIKS_DICTIONARY_H
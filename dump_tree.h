@@ -29,28 +29,29 @@
 #include <iomanip>
 #include <cctype>
 
-template <typename T>
-void print_huffman_tree(const Dictionary<T>* tree, std::ostream& s, int depth = 0)
+inline void print_huffman_tree(const HuffmanTree& tree, unsigned short node, std::ostream& s, int depth)
 {
 	for (int i = 0; i < depth; ++i)
 		s << '\t';
 
-	if (const DictValue<unsigned char> *dict_val = dynamic_cast<const DictValue<unsigned char>*>(tree))
+	const DictEntry& dict = tree[node];
+
+	if (dict.type == DICT_VALUE)
 	{
-		s << "| 0x" << std::setfill('0') << std::setw(2) << std::hex << std::uppercase << (unsigned int)dict_val->val;
-		if (std::isprint(dict_val->val))
-			s << " (" << dict_val->val << ")";
+		s << "| 0x" << std::setfill('0') << std::setw(2) << std::hex << std::uppercase << (unsigned int)dict.val;
+		if (std::isprint(dict.val))
+			s << " (" << dict.val << ")";
 		s << '\n';
 	}
-	else if (const DictNode<unsigned char> *dict_node = dynamic_cast<const DictNode<unsigned char>*>(tree))
+	else if (dict.type == DICT_NODE)
 	{
 		s << "+ L\n";
-		print_huffman_tree(dict_node->l, s, depth+1);
+		print_huffman_tree(tree, dict.l, s, depth+1);
 
 		for (int i = 0; i < depth; ++i)
 			s << '\t';
 		s << "+ R\n";
-		print_huffman_tree(dict_node->r, s, depth+1);
+		print_huffman_tree(tree, dict.r, s, depth+1);
 	}
 	else // EOF
 	{
@@ -58,4 +59,9 @@ void print_huffman_tree(const Dictionary<T>* tree, std::ostream& s, int depth =
 	}
 }
 
+inline void print_huffman_tree(const HuffmanTree& tree, std::ostream& s)
+{
+	print_huffman_tree(tree, tree.root(), s, 0);
+}
+
 #endif // YURIKS_DUMP_TREE_H
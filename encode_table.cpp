@@ -0,0 +1,119 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "encode_table.h"
+#include "canonical.h"
+
+EncodeTable::EncodeTable()
+{
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		codes[i].bits = 0;
+		codes[i].length = 0;
+	}
+}
+
+EncodeTable::EncodeTable(const HuffmanTree& tree)
+{
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		codes[i].bits = 0;
+		codes[i].length = 0;
+	}
+
+	populate(tree, tree.root(), 0, 0);
+}
+
+EncodeTable::EncodeTable(const unsigned char* lengths)
+{
+	build(lengths);
+}
+
+void EncodeTable::build(const unsigned char* lengths)
+{
+	long_codes.clear();
+
+	unsigned int canonical[HUFFMAN_NUM_SYMBOLS];
+	canonical_codes(lengths, canonical);
+
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		codes[i].bits = canonical[i];
+		codes[i].length = lengths[i];
+	}
+}
+
+void EncodeTable::setCode(const DictEntry& dict, unsigned long long bits, unsigned int length)
+{
+	unsigned int symbol = HUFFMAN_EOF;
+	if (dict.type == DICT_VALUE)
+		symbol = dict.val;
+
+	codes[symbol].bits = bits;
+	codes[symbol].length = length;
+}
+
+void EncodeTable::populate(const HuffmanTree& tree, unsigned short node, unsigned long long bits, unsigned int length)
+{
+	const DictEntry& dict = tree[node];
+
+	if (dict.type != DICT_NODE)
+	{
+		setCode(dict, bits, length);
+		return;
+	}
+
+	if (length == max_code_length)
+	{
+		// Children won't fit in 64 bits, continue with a Bitstream
+		Bitstream path;
+		for (int i = max_code_length-1; i >= 0; --i)
+			path.push_back(((bits >> i) & 1) != 0);
+
+		populateLong(tree, node, path);
+		return;
+	}
+
+	populate(tree, dict.l, bits << 1, length+1);
+	populate(tree, dict.r, (bits << 1) | 1, length+1);
+}
+
+void EncodeTable::populateLong(const HuffmanTree& tree, unsigned short node, const Bitstream& path)
+{
+	const DictEntry& dict = tree[node];
+
+	if (dict.type != DICT_NODE)
+	{
+		setCode(dict, long_codes.size(), path.length());
+		long_codes.push_back(path);
+		return;
+	}
+
+	Bitstream path_l = path;
+	Bitstream path_r = path;
+
+	path_l.push_back(false);
+	populateLong(tree, dict.l, path_l);
+	path_r.push_back(true);
+	populateLong(tree, dict.r, path_r);
+}
@@ -0,0 +1,79 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_ENCODE_TABLE_H
+#define YURIKS_ENCODE_TABLE_H
+
+#include "dictionary.h"
+#include "bitstream.h"
+
+#include <vector>
+
+struct HuffmanCode
+{
+	// Right-aligned code, or index into EncodeTable::long_codes if length
+	// is greater than EncodeTable::max_code_length.
+	unsigned long long bits;
+	unsigned int length;
+};
+
+// Flat symbol -> code table, the encoding counterpart of DecodeTable.
+class EncodeTable
+{
+public:
+	static const unsigned int max_code_length = 64;
+
+	// Empty table, build() must be called before encoding.
+	EncodeTable();
+	explicit EncodeTable(const HuffmanTree& tree);
+	// Builds the table for the canonical code with these code lengths.
+	explicit EncodeTable(const unsigned char* lengths);
+
+	// Rebuilds the table in place for another canonical code.
+	void build(const unsigned char* lengths);
+
+	template <typename Writer>
+	void encode(Writer& stream, unsigned int symbol) const;
+
+	HuffmanCode codes[HUFFMAN_NUM_SYMBOLS];
+	// Only very skewed inputs produce codes this long
+	std::vector<Bitstream> long_codes;
+
+private:
+	void populate(const HuffmanTree& tree, unsigned short node, unsigned long long bits, unsigned int length);
+	void populateLong(const HuffmanTree& tree, unsigned short node, const Bitstream& path);
+	void setCode(const DictEntry& dict, unsigned long long bits, unsigned int length);
+};
+
+template <typename Writer>
+inline void EncodeTable::encode(Writer& stream, unsigned int symbol) const
+{
+	const HuffmanCode& code = codes[symbol];
+
+	if (code.length <= max_code_length)
+		stream.pushBits(code.bits, code.length);
+	else
+		stream.push_back(long_codes[code.bits]);
+}
+
+#endif // YURIKS_ENCODE_TABLE_H
@@ -0,0 +1,546 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "file_io.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#	include <io.h>
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	include <errno.h>
+#	include <dirent.h>
+#endif
+
+namespace
+{
+
+enum
+{
+	BUFFER_SIZE = 1024 * 1024,
+	BUFFER_ALIGNMENT = 4096
+};
+
+char* alloc_buffer()
+{
+#if defined(_WIN32)
+	return static_cast<char*>(_aligned_malloc(BUFFER_SIZE, BUFFER_ALIGNMENT));
+#else
+	void* p = 0;
+	if (posix_memalign(&p, BUFFER_ALIGNMENT, BUFFER_SIZE) != 0)
+		return 0;
+	return static_cast<char*>(p);
+#endif
+}
+
+void free_buffer(char* p)
+{
+#if defined(_WIN32)
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+bool is_regular(int fd, unsigned long long& size)
+{
+#if defined(_WIN32)
+	struct _stati64 st;
+	if (_fstati64(fd, &st) != 0)
+		return false;
+#else
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+		return false;
+#endif
+
+	size = st.st_size;
+	return (st.st_mode & S_IFMT) == S_IFREG;
+}
+
+#if !defined(_WIN32)
+// Sizes the file to `size` bytes with the disk space actually allocated,
+// so running out of space shows up here instead of as a SIGBUS when a page
+// of the mapping is first written.
+bool reserve_file(int fd, unsigned long long size)
+{
+#	if defined(__APPLE__)
+	fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0 };
+	if (fcntl(fd, F_PREALLOCATE, &store) == -1)
+		return false;
+	return ftruncate(fd, static_cast<off_t>(size)) == 0;
+#	else
+	return posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0;
+#	endif
+}
+#endif
+
+bool list_files_under(const std::string& dir, const std::string& prefix, std::vector<std::string>& names)
+{
+	std::vector<std::string> entries;
+
+#if defined(_WIN32)
+	WIN32_FIND_DATAA found;
+	HANDLE handle = FindFirstFileA((dir + "\\*").c_str(), &found);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	do
+		entries.push_back(found.cFileName);
+	while (FindNextFileA(handle, &found));
+	FindClose(handle);
+#else
+	DIR* d = opendir(dir.c_str());
+	if (d == 0)
+		return false;
+	while (dirent* entry = readdir(d))
+		entries.push_back(entry->d_name);
+	closedir(d);
+#endif
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (entries[i] == "." || entries[i] == "..")
+			continue;
+
+		std::string path = dir + "/" + entries[i];
+		unsigned long long size;
+		if (regular_file_size(path, size))
+			names.push_back(prefix + entries[i]);
+		else if (is_directory(path) && !list_files_under(path, prefix + entries[i] + "/", names))
+			return false;
+	}
+
+	return true;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool regular_file_size(const std::string& name, unsigned long long& size)
+{
+#if defined(_WIN32)
+	struct _stati64 st;
+	if (_stati64(name.c_str(), &st) != 0)
+		return false;
+#else
+	struct stat st;
+	if (stat(name.c_str(), &st) != 0)
+		return false;
+#endif
+
+	size = st.st_size;
+	return (st.st_mode & S_IFMT) == S_IFREG;
+}
+
+bool is_directory(const std::string& name)
+{
+#if defined(_WIN32)
+	struct _stati64 st;
+	if (_stati64(name.c_str(), &st) != 0)
+		return false;
+#else
+	struct stat st;
+	if (stat(name.c_str(), &st) != 0)
+		return false;
+#endif
+
+	return (st.st_mode & S_IFMT) == S_IFDIR;
+}
+
+bool list_files(const std::string& dir, std::vector<std::string>& names)
+{
+	return list_files_under(dir, "", names);
+}
+
+bool make_directories(const std::string& name)
+{
+	if (name.empty() || is_directory(name))
+		return true;
+
+	std::string::size_type slash = name.find_last_of("/\\");
+	if (slash != std::string::npos && slash != 0 && !make_directories(name.substr(0, slash)))
+		return false;
+
+#if defined(_WIN32)
+	CreateDirectoryA(name.c_str(), NULL);
+#else
+	mkdir(name.c_str(), 0777);
+#endif
+	// Someone else may have made it in the meantime
+	return is_directory(name);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+InputFile::InputFile()
+	: fd(-1), mapping(0), data_(0), size_(0), mapped_(false), seekable_(false)
+{
+}
+
+InputFile::~InputFile()
+{
+	close();
+}
+
+bool InputFile::open(const char* name)
+{
+	close();
+
+#if defined(_WIN32)
+	fd = _open(name, _O_RDONLY | _O_BINARY);
+#else
+	fd = ::open(name, O_RDONLY);
+#endif
+	if (fd < 0)
+		return false;
+
+	map();
+	return true;
+}
+
+bool InputFile::openStdin()
+{
+	close();
+
+#if defined(_WIN32)
+	// Also makes the standard streams binary
+	_setmode(0, _O_BINARY);
+	fd = _dup(0);
+	if (fd < 0)
+		return false;
+#else
+	fd = dup(0);
+	if (fd < 0)
+		return false;
+#endif
+
+	map();
+	return true;
+}
+
+void InputFile::map()
+{
+	unsigned long long size;
+	if (!is_regular(fd, size))
+		return;
+
+	seekable_ = true;
+	size_ = size;
+
+	if (size == 0)
+	{
+		// Nothing to map, but the view is valid
+		mapped_ = true;
+		return;
+	}
+	if (size != static_cast<size_t>(size))
+		return;
+
+#if defined(_WIN32)
+	HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+	mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		mapping = 0;
+		return;
+	}
+
+	void* p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (p == NULL)
+		return;
+#else
+	void* p = mmap(0, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED)
+		return;
+
+	// The codec makes one pass front to back
+	madvise(p, static_cast<size_t>(size), MADV_SEQUENTIAL);
+#endif
+
+	data_ = static_cast<const unsigned char*>(p);
+	mapped_ = true;
+	return;
+}
+
+void InputFile::close()
+{
+	if (data_ != 0)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(data_);
+#else
+		munmap(const_cast<unsigned char*>(data_), static_cast<size_t>(size_));
+#endif
+	}
+
+#if defined(_WIN32)
+	if (mapping != 0)
+		CloseHandle(mapping);
+	if (fd >= 0)
+		_close(fd);
+#else
+	if (fd >= 0)
+		::close(fd);
+#endif
+
+	fd = -1;
+	mapping = 0;
+	data_ = 0;
+	size_ = 0;
+	mapped_ = false;
+	seekable_ = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutputFileBuf::OutputFileBuf()
+	: fd(-1), buffer(0), failed(false), can_map(false), mapping(0), map_data(0), map_size(0)
+{
+}
+
+OutputFileBuf::~OutputFileBuf()
+{
+	close();
+}
+
+bool OutputFileBuf::open(const char* name)
+{
+	close();
+
+#if defined(_WIN32)
+	fd = _open(name, _O_RDWR | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+	fd = ::open(name, O_RDWR | O_CREAT | O_TRUNC, 0666);
+#endif
+	if (fd < 0)
+		return false;
+
+	can_map = true;
+	return allocBuffer();
+}
+
+bool OutputFileBuf::openStdout()
+{
+	close();
+
+#if defined(_WIN32)
+	// Also makes the standard streams binary
+	_setmode(1, _O_BINARY);
+	fd = _dup(1);
+	if (fd < 0)
+		return false;
+#else
+	fd = dup(1);
+	if (fd < 0)
+		return false;
+#endif
+
+	// Could be a pipe, or a file opened for appending
+	can_map = false;
+	return allocBuffer();
+}
+
+bool OutputFileBuf::allocBuffer()
+{
+	buffer = alloc_buffer();
+	if (buffer == 0)
+	{
+		close();
+		return false;
+	}
+
+	failed = false;
+	setp(buffer, buffer + BUFFER_SIZE);
+	return true;
+}
+
+bool OutputFileBuf::close()
+{
+	if (fd < 0)
+		return !failed;
+
+	flushBuffer();
+
+	if (map_data != 0)
+	{
+#if defined(_WIN32)
+		if (!FlushViewOfFile(map_data, 0) || !UnmapViewOfFile(map_data))
+			failed = true;
+#else
+		if (munmap(map_data, static_cast<size_t>(map_size)) != 0)
+			failed = true;
+#endif
+	}
+
+#if defined(_WIN32)
+	if (mapping != 0)
+		CloseHandle(mapping);
+	_close(fd);
+#else
+	if (::close(fd) != 0)
+		failed = true;
+#endif
+
+	free_buffer(buffer);
+	fd = -1;
+	buffer = 0;
+	mapping = 0;
+	map_data = 0;
+	map_size = 0;
+	setp(0, 0);
+
+	return !failed;
+}
+
+unsigned char* OutputFileBuf::map(unsigned long long size)
+{
+	if (fd < 0 || !can_map || size == 0 || map_data != 0 || pptr() != pbase())
+		return 0;
+	if (size != static_cast<size_t>(size))
+		return 0;
+
+#if defined(_WIN32)
+	HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+	mapping = CreateFileMappingA(handle, NULL, PAGE_READWRITE,
+		static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), NULL);
+	if (mapping == NULL)
+	{
+		mapping = 0;
+		return 0;
+	}
+
+	void* p = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(size));
+	if (p == NULL)
+	{
+		CloseHandle(mapping);
+		mapping = 0;
+		return 0;
+	}
+#else
+	if (!reserve_file(fd, size))
+	{
+		// Whatever was allocated is dropped, and the output is written
+		// through the stream instead
+		if (ftruncate(fd, 0) != 0)
+			failed = true;
+		return 0;
+	}
+
+	void* p = mmap(0, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED)
+	{
+		if (ftruncate(fd, 0) != 0)
+			failed = true;
+		return 0;
+	}
+#endif
+
+	map_data = static_cast<unsigned char*>(p);
+	map_size = size;
+	return map_data;
+}
+
+bool OutputFileBuf::writeAll(const char* s, size_t n)
+{
+	while (n > 0 && !failed)
+	{
+#if defined(_WIN32)
+		unsigned int chunk = n > (1u << 30) ? (1u << 30) : static_cast<unsigned int>(n);
+		int written = _write(fd, s, chunk);
+		if (written <= 0)
+			failed = true;
+#else
+		ssize_t written = ::write(fd, s, n);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			failed = true;
+#endif
+		else
+		{
+			s += written;
+			n -= written;
+		}
+	}
+
+	return !failed;
+}
+
+bool OutputFileBuf::flushBuffer()
+{
+	if (pbase() == pptr())
+		return !failed;
+
+	bool ok = writeAll(pbase(), pptr() - pbase());
+	setp(buffer, buffer + BUFFER_SIZE);
+	return ok;
+}
+
+OutputFileBuf::int_type OutputFileBuf::overflow(int_type c)
+{
+	if (fd < 0 || !flushBuffer())
+		return traits_type::eof();
+
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+	{
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+
+	return traits_type::not_eof(c);
+}
+
+std::streamsize OutputFileBuf::xsputn(const char* s, std::streamsize n)
+{
+	if (fd < 0)
+		return 0;
+
+	if (n < epptr() - pptr())
+	{
+		std::memcpy(pptr(), s, static_cast<size_t>(n));
+		pbump(static_cast<int>(n));
+		return n;
+	}
+
+	// Doesn't fit, write it out directly rather than copying through
+	if (!flushBuffer() || !writeAll(s, static_cast<size_t>(n)))
+		return 0;
+
+	return n;
+}
+
+int OutputFileBuf::sync()
+{
+	return flushBuffer() ? 0 : -1;
+}
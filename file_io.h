@@ -0,0 +1,144 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_FILE_IO_H
+#define YURIKS_FILE_IO_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Read-only view of an input file. Regular files are memory mapped, so
+// the codec can work on the bytes in place. Anything else (pipes,
+// terminals) isn't mapped and has to be read as a stream.
+class InputFile
+{
+public:
+	InputFile();
+	~InputFile();
+
+	// Returns false if the file can't be opened.
+	bool open(const char* name);
+	// Same for standard input, which is mapped too if redirected from a file.
+	bool openStdin();
+	void close();
+
+	bool mapped() const;
+	// Regular file, so it can be read more than once
+	bool seekable() const;
+	// Only valid if the file is seekable
+	const unsigned char* data() const;
+	unsigned long long size() const;
+
+private:
+	InputFile(const InputFile&);
+	InputFile& operator=(const InputFile&);
+
+	void map();
+
+	int fd;
+	void* mapping;
+	const unsigned char* data_;
+	unsigned long long size_;
+	bool mapped_;
+	bool seekable_;
+};
+
+inline bool InputFile::mapped() const
+{
+	return mapped_;
+}
+
+inline bool InputFile::seekable() const
+{
+	return seekable_;
+}
+
+inline const unsigned char* InputFile::data() const
+{
+	return data_;
+}
+
+inline unsigned long long InputFile::size() const
+{
+	return size_;
+}
+
+// Output file stream buffer. Writes go through a large aligned buffer
+// straight to the file descriptor, and big writes bypass the buffer
+// entirely. Use it with a plain std::ostream.
+class OutputFileBuf : public std::streambuf
+{
+public:
+	OutputFileBuf();
+	~OutputFileBuf();
+
+	// Returns false if the file can't be created.
+	bool open(const char* name);
+	// Writes to standard output. It's never mapped.
+	bool openStdout();
+	// Flushes and closes the file. Returns false if any write failed.
+	bool close();
+
+	// Sizes the file to exactly `size` bytes, with the disk space reserved,
+	// and maps it for writing, for callers that know the output size up
+	// front. Returns 0 if the file can't be mapped or the space reserved;
+	// then it should be written through the stream, which must not be mixed
+	// with the mapping otherwise.
+	unsigned char* map(unsigned long long size);
+
+protected:
+	virtual int_type overflow(int_type c);
+	virtual std::streamsize xsputn(const char* s, std::streamsize n);
+	virtual int sync();
+
+private:
+	OutputFileBuf(const OutputFileBuf&);
+	OutputFileBuf& operator=(const OutputFileBuf&);
+
+	bool allocBuffer();
+	bool flushBuffer();
+	bool writeAll(const char* s, size_t n);
+
+	int fd;
+	char* buffer;
+	bool failed;
+	bool can_map;
+
+	void* mapping;
+	unsigned char* map_data;
+	unsigned long long map_size;
+};
+
+// Size of a regular file. Returns false for anything else.
+bool regular_file_size(const std::string& name, unsigned long long& size);
+bool is_directory(const std::string& name);
+// Appends the regular files under dir and its subdirectories, as paths
+// relative to dir, using '/' as the separator. Returns false if dir can't
+// be read.
+bool list_files(const std::string& dir, std::vector<std::string>& names);
+// Creates a directory and any missing parents. Returns false unless it
+// exists afterwards.
+bool make_directories(const std::string& name);
+
+#endif // YURIKS_FILE_IO_H
@@ -0,0 +1,131 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "histogram.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+enum
+{
+	// Repeated bytes increment the same counter back to back, which stalls
+	// on store-to-load forwarding. Spreading consecutive bytes over
+	// separate tables breaks up those chains.
+	TABLES = 4,
+	// Keeps the 32-bit counters of a table from overflowing
+	MAX_CHUNK = 1 << 30,
+	// Smaller buffers aren't worth handing to other threads
+	MIN_PARALLEL_CHUNK = 1 << 20
+};
+
+void count_chunk(const unsigned char* data, size_t size, unsigned int (*tables)[HISTOGRAM_SIZE])
+{
+	unsigned int* t0 = tables[0];
+	unsigned int* t1 = tables[1];
+	unsigned int* t2 = tables[2];
+	unsigned int* t3 = tables[3];
+
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16)
+	{
+		unsigned long long a, b;
+		std::memcpy(&a, data + i, 8);
+		std::memcpy(&b, data + i + 8, 8);
+
+		// Byte order doesn't matter, every byte is counted once
+		++t0[a & 0xFF];         ++t1[(a >> 8) & 0xFF];
+		++t2[(a >> 16) & 0xFF]; ++t3[(a >> 24) & 0xFF];
+		++t0[(a >> 32) & 0xFF]; ++t1[(a >> 40) & 0xFF];
+		++t2[(a >> 48) & 0xFF]; ++t3[a >> 56];
+		++t0[b & 0xFF];         ++t1[(b >> 8) & 0xFF];
+		++t2[(b >> 16) & 0xFF]; ++t3[(b >> 24) & 0xFF];
+		++t0[(b >> 32) & 0xFF]; ++t1[(b >> 40) & 0xFF];
+		++t2[(b >> 48) & 0xFF]; ++t3[b >> 56];
+	}
+
+	for (; i < size; ++i)
+		++t0[data[i]];
+}
+
+} // namespace
+
+void histogram(const unsigned char* data, size_t size, unsigned long long* counts)
+{
+	unsigned int tables[TABLES][HISTOGRAM_SIZE];
+
+	for (int b = 0; b < HISTOGRAM_SIZE; ++b)
+		counts[b] = 0;
+
+	while (size > 0)
+	{
+		size_t chunk = std::min<size_t>(size, MAX_CHUNK);
+
+		std::memset(tables, 0, sizeof(tables));
+		count_chunk(data, chunk, tables);
+
+		for (int b = 0; b < HISTOGRAM_SIZE; ++b)
+			counts[b] += static_cast<unsigned long long>(tables[0][b]) + tables[1][b] + tables[2][b] + tables[3][b];
+
+		data += chunk;
+		size -= chunk;
+	}
+}
+
+void histogram_parallel(const unsigned char* data, size_t size, unsigned long long* counts, ThreadPool& pool)
+{
+	size_t parts = pool.size();
+	if (size / MIN_PARALLEL_CHUNK < parts)
+		parts = size / MIN_PARALLEL_CHUNK;
+
+	if (parts <= 1)
+	{
+		histogram(data, size, counts);
+		return;
+	}
+
+	std::vector<unsigned long long> partial(parts * HISTOGRAM_SIZE);
+	std::vector<std::future<void> > pending;
+
+	size_t part_size = size / parts;
+	for (size_t i = 0; i < parts; ++i)
+	{
+		size_t n = (i + 1 == parts) ? size - i * part_size : part_size;
+		pending.push_back(pool.submit(std::bind(histogram, data + i * part_size, n, &partial[i * HISTOGRAM_SIZE])));
+	}
+
+	for (int b = 0; b < HISTOGRAM_SIZE; ++b)
+		counts[b] = 0;
+
+	for (size_t i = 0; i < parts; ++i)
+	{
+		pending[i].get();
+
+		for (int b = 0; b < HISTOGRAM_SIZE; ++b)
+			counts[b] += partial[i * HISTOGRAM_SIZE + b];
+	}
+}
@@ -0,0 +1,304 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *               2010 Hugo S. K. Puhlmann
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "huffman.h"
+#include "decode_table.h"
+#include "multi_decode_table.h"
+#include "canonical.h"
+
+#include <algorithm>
+
+namespace YURIKS_HUFFMAN_CPP
+{
+
+void serialize_dictionary(OFileBitstream& s, const HuffmanTree& tree, unsigned short node)
+{
+	const DictEntry& dict = tree[node];
+
+	switch (dict.type)
+	{
+	case DICT_VALUE:
+	{
+		s.push_back(false);
+		s.push_back(dict.val);
+		// To differentiate from EOF
+		if (dict.val == 0)
+			s.push_back(false);
+	} break;
+	case DICT_NODE:
+	{
+		s.push_back(true);
+		serialize_dictionary(s, tree, dict.l);
+		serialize_dictionary(s, tree, dict.r);
+	} break;
+	case DICT_NONE_EOF:
+	{
+		s.push_back(false);
+		// EOF marker: 0 followed by bit 1
+		s.push_back(static_cast<unsigned char>(0));
+		s.push_back(true);
+	} break;
+	}
+}
+
+unsigned short read_node(IFileBitstream& stream, HuffmanTree& tree)
+{
+	if (stream.nextBit())
+	{
+		// Children come after their parent in the stream
+		unsigned short node = tree.addNode();
+		unsigned short l = read_node(stream, tree);
+		unsigned short r = read_node(stream, tree);
+		tree[node].l = l;
+		tree[node].r = r;
+		return node;
+	}
+	else
+	{
+		unsigned char val = stream.nextChar();
+		if (val == 0)
+			if (stream.nextBit() == true)
+				return tree.addEof();
+		return tree.addValue(val);
+	}
+}
+
+struct WeightedNode
+{
+	unsigned long long weight;
+	unsigned short node;
+};
+
+bool lighter_node(const WeightedNode& a, const WeightedNode& b)
+{
+	return a.weight < b.weight || (a.weight == b.weight && a.node < b.node);
+}
+
+// Two-queue construction: once the leaves are sorted, merged nodes come out
+// in order of weight too, so the two lightest items are always at the
+// front of one of the two queues.
+void build_tree(const unsigned long long* frequency, HuffmanTree& tree)
+{
+	WeightedNode leaves[HUFFMAN_NUM_SYMBOLS];
+	WeightedNode merged[HUFFMAN_NUM_SYMBOLS];
+	unsigned int leaf_count = 0;
+
+	tree.clear();
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		if (frequency[i] > 0)
+		{
+			WeightedNode leaf = { frequency[i], i == HUFFMAN_EOF ? tree.addEof() : tree.addValue(static_cast<unsigned char>(i)) };
+			leaves[leaf_count++] = leaf;
+		}
+	}
+
+	std::sort(leaves, leaves + leaf_count, lighter_node);
+
+	unsigned int leaf = 0;
+	unsigned int head = 0;
+	unsigned int tail = 0;
+
+	for (unsigned int i = 1; i < leaf_count; ++i)
+	{
+		WeightedNode pair[2];
+		for (int k = 0; k < 2; ++k)
+		{
+			if (leaf < leaf_count && (head == tail || leaves[leaf].weight <= merged[head].weight))
+				pair[k] = leaves[leaf++];
+			else
+				pair[k] = merged[head++];
+		}
+
+		WeightedNode node = { pair[0].weight + pair[1].weight, tree.addNode(pair[0].node, pair[1].node) };
+		merged[tail++] = node;
+	}
+
+	tree.setRoot(tail != 0 ? merged[tail-1].node : leaves[0].node);
+}
+
+void decode_stream(const DecodeTable& table, const MultiDecodeTable& multi, IFileBitstream& stream,
+	std::ostream& output, unsigned long long size, Stats* stats)
+{
+	PhaseTimer timer(stats, PHASE_DECODE);
+
+	// Decoded bytes are collected here instead of going to the stream one
+	// at a time
+	char buffer[64 * 1024];
+	size_t buffered = 0;
+	unsigned long long symbols = 0;
+	const unsigned long long start_pos = stream.bytesConsumed();
+
+	try
+	{
+		while (true)
+		{
+			unsigned int val = 0;
+			if (!multi.empty())
+			{
+				unsigned char* out = reinterpret_cast<unsigned char*>(buffer);
+				unsigned int count;
+
+				while (buffered + MultiDecodeTable::max_symbols <= sizeof(buffer))
+				{
+					val = multi.decode(stream, table, out + buffered, count);
+					if (val >= HUFFMAN_EOF)
+						break;
+
+					buffered += count;
+				}
+			}
+			else
+			{
+				while (buffered < sizeof(buffer))
+				{
+					val = table.decode(stream);
+					if (val >= HUFFMAN_EOF)
+						break;
+
+					buffer[buffered++] = (char)val;
+				}
+			}
+
+			output.write(buffer, buffered);
+			symbols += buffered;
+			buffered = 0;
+
+			if (val >= HUFFMAN_EOF)
+			{
+				if (val != HUFFMAN_EOF)
+					throw std::ios_base::failure("invalid code");
+				break;
+			}
+
+			// Progress is only looked at once per buffer
+			if (stats != 0)
+				stats->progress(stream.bytesConsumed() - start_pos, size);
+		}
+	}
+	catch (std::ifstream::failure&)
+	{
+		// Keep what was decoded before the error, and let the caller
+		// report it
+		output.write(buffer, buffered);
+		throw;
+	}
+
+	if (stats != 0)
+	{
+		stats->progress(stream.bytesConsumed() - start_pos, size);
+		stats->bytes_in += stream.bytesConsumed();
+		stats->bytes_out += symbols;
+		stats->symbols += symbols;
+		stats->bits += (stream.bytesConsumed() - start_pos) * 8;
+	}
+}
+
+} // namespace YURIKS_HUFFMAN_CPP
+
+void huffman_uncompress(IFileBitstream& stream, std::ostream& output, const HuffmanTree& tree, unsigned long long size, Stats* stats)
+{
+	using namespace YURIKS_HUFFMAN_CPP;
+
+	PhaseTimer table_timer(stats, PHASE_TREE);
+	const DecodeTable table(tree);
+	MultiDecodeTable multi;
+	multi.build(tree);
+	table_timer.stop();
+
+	decode_stream(table, multi, stream, output, size, stats);
+}
+
+void huffman_uncompress_canonical(IFileBitstream& stream, std::ostream& output, unsigned long long size, Stats* stats)
+{
+	using namespace YURIKS_HUFFMAN_CPP;
+
+	PhaseTimer header_timer(stats, PHASE_HEADER);
+	const unsigned long long header_pos = stream.bytesConsumed();
+	unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+	read_code_lengths(stream, lengths);
+	header_timer.stop();
+
+	// Progress is of the coded data after the lengths, as for trees
+	if (size != 0)
+		size -= stream.bytesConsumed() - header_pos;
+
+	PhaseTimer table_timer(stats, PHASE_TREE);
+	const DecodeTable table(lengths);
+	MultiDecodeTable multi;
+	multi.build(lengths);
+	table_timer.stop();
+
+	decode_stream(table, multi, stream, output, size, stats);
+}
+
+void build_huffman_tree(const unsigned long long* frequency, HuffmanTree& tree, Stats* stats)
+{
+	using namespace YURIKS_HUFFMAN_CPP;
+
+	PhaseTimer timer(stats, PHASE_TREE);
+	build_tree(frequency, tree);
+}
+
+void build_canonical_code(const unsigned long long* frequency, unsigned int max_length, unsigned char* lengths, Stats* stats)
+{
+	PhaseTimer timer(stats, PHASE_TREE);
+	build_code_lengths(frequency, max_length, lengths);
+}
+
+void write_format(OFileBitstream& stream, HuffmanFormat format)
+{
+	stream.push_back(static_cast<unsigned char>('H'));
+	stream.push_back(static_cast<unsigned char>('Z'));
+	stream.push_back(static_cast<unsigned char>(format));
+}
+
+HuffmanFormat read_format(std::istream& stream)
+{
+	if (stream.peek() != 'H')
+		return FORMAT_TREE;
+
+	char magic[FORMAT_HEADER_SIZE];
+	if (!stream.read(magic, FORMAT_HEADER_SIZE) || magic[1] != 'Z')
+		throw std::ios_base::failure("unknown file format");
+
+	if (magic[2] != FORMAT_CANONICAL && magic[2] != FORMAT_BLOCKS && magic[2] != FORMAT_ADAPTIVE)
+		throw std::ios_base::failure("unknown file format");
+
+	return static_cast<HuffmanFormat>(magic[2]);
+}
+
+void readNode(IFileBitstream& stream, HuffmanTree& tree, Stats* stats)
+{
+	using namespace YURIKS_HUFFMAN_CPP;
+
+	PhaseTimer timer(stats, PHASE_HEADER);
+
+	tree.clear();
+	tree.setRoot(read_node(stream, tree));
+
+	// A lone symbol would have an empty code and decode forever
+	if (tree[tree.root()].type == DICT_VALUE)
+		throw std::ios_base::failure("invalid tree");
+}
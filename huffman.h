@@ -25,73 +25,56 @@
 #define YURIKS_HUFFMAN_H
 
 #include "bitstream.h"
+#include "dictionary.h"
+#include "stats.h"
 
-enum DictType
+// Every format but the original tree one starts with "HZ" and a format
+// number. A tree stream can't start with 'H': its first bit is 1 unless the
+// tree is a lone EOF, which is serialized as 0x00.
+enum HuffmanFormat
 {
-	DICT_NONE_EOF,
-	DICT_VALUE,
-	DICT_NODE
+	FORMAT_TREE,
+	FORMAT_CANONICAL, // Code lengths, then the data
+	FORMAT_BLOCKS,    // See container.h
+	FORMAT_ADAPTIVE   // See adaptive.h
 };
 
-template <typename T>
-struct Dictionary
-{
-	DictType type;
-
-	Dictionary() : type(DICT_NONE_EOF) {}
-	virtual ~Dictionary() {}
-
-	virtual DictType getType() const { return DICT_NONE_EOF; }
-};
-
-template <typename T>
-struct DictValue : Dictionary<T>
-{
-	DictValue(T val);
-
-	virtual DictType getType() const { return DICT_VALUE; }
-
-	T val;
-};
-
-template <typename T>
-struct DictNode : Dictionary<T>
-{
-	DictNode();
-	DictNode(Dictionary<T> *l, Dictionary<T> *r);
-
-	virtual DictType getType() const { return DICT_NODE; }
-
-	Dictionary<T> *l, *r;
-};
+// Every function takes an optional Stats to report progress, phase times
+// and counters to. size is the input size, only used for progress; 0 if
+// unknown. The compressors add the count of every symbol they code, EOF
+// included, to counts if given, which takes a little longer.
 
 template <typename Iter>
-Dictionary<unsigned char>* build_huffman_tree(Iter& begin, const Iter& end);
+void build_huffman_tree(Iter& begin, const Iter& end, HuffmanTree& tree, Stats* stats = 0);
+// From HUFFMAN_NUM_SYMBOLS counts made elsewhere, such as by sample_frequency
+void build_huffman_tree(const unsigned long long* frequency, HuffmanTree& tree, Stats* stats = 0);
 template <typename Iter>
-void huffman_compress(Dictionary<unsigned char>* tree, OFileBitstream& stream, Iter& begin, const Iter& end);
-Dictionary<unsigned char>* readNode(IFileBitstream& stream);
-
-void huffman_uncompress(IFileBitstream& stream, std::ostream& output);
-
-///////////////////////////////////////////////////////////////////////////////
+void huffman_compress(const HuffmanTree& tree, OFileBitstream& stream, Iter& begin, const Iter& end, unsigned long long size,
+	Stats* stats = 0, unsigned long long* counts = 0);
+// Reads a serialized tree into `tree`.
+void readNode(IFileBitstream& stream, HuffmanTree& tree, Stats* stats = 0);
 
-template <typename T>
-inline DictValue<T>::DictValue(T val)
-	: val(val)
-{
-}
+void huffman_uncompress(IFileBitstream& stream, std::ostream& output, const HuffmanTree& tree, unsigned long long size, Stats* stats = 0);
 
-template <typename T>
-inline DictNode<T>::DictNode()
-	: l(0), r(0)
+template <typename Iter>
+void build_canonical_code(Iter& begin, const Iter& end, unsigned int max_length, unsigned char* lengths, Stats* stats = 0);
+void build_canonical_code(const unsigned long long* frequency, unsigned int max_length, unsigned char* lengths, Stats* stats = 0);
+template <typename Iter>
+void huffman_compress_canonical(const unsigned char* lengths, OFileBitstream& stream, Iter& begin, const Iter& end, unsigned long long size,
+	Stats* stats = 0, unsigned long long* counts = 0);
+// size counts the code lengths the stream starts with
+void huffman_uncompress_canonical(IFileBitstream& stream, std::ostream& output, unsigned long long size, Stats* stats = 0);
+
+// Size of the header write_format writes, "HZ" and the format number.
+// Tree streams have none.
+enum
 {
-}
+	FORMAT_HEADER_SIZE = 3
+};
 
-template <typename T>
-inline DictNode<T>::DictNode(Dictionary<T> *l, Dictionary<T> *r)
-	: l(l), r(r)
-{
-}
+void write_format(OFileBitstream& stream, HuffmanFormat format);
+// Consumes the format header, if there is one.
+HuffmanFormat read_format(std::istream& stream);
 
 #include "huffman.hpp"
 
@@ -23,262 +23,173 @@
  * THE SOFTWARE.
  */
 #include "huffman.h"
+#include "encode_table.h"
+#include "canonical.h"
+#include "histogram.h"
 
-#include <limits>
-#include <vector>
-#include <queue>
 #include <algorithm>
-#include <numeric>
-#include <cassert>
 
 namespace YURIKS_HUFFMAN_CPP
 {
 
+// Fills in HUFFMAN_NUM_SYMBOLS counts, EOF appearing once
 template <typename Iter>
-std::vector<unsigned long> make_frequency(Iter begin, const Iter& end)
+void make_frequency(Iter begin, const Iter& end, unsigned long long* frequency)
 {
-	const unsigned char max_val = std::numeric_limits<unsigned char>::max();
-
-	std::vector<unsigned long> frequency(max_val+1, 0);
+	std::fill_n(frequency, HUFFMAN_NUM_SYMBOLS, 0ULL);
 
 	for (; begin != end; ++begin)
 	{
 		++frequency[(unsigned char)(*begin)];
 	}
 
-	return frequency;
+	frequency[HUFFMAN_EOF] = 1;
 }
 
-void populate_reverse_map(std::vector<Bitstream*>& map, Dictionary<unsigned char> *dict, Bitstream path)
+// Contiguous buffers use the multi-table histogram kernel
+inline void make_frequency(const unsigned char* begin, const unsigned char* end, unsigned long long* frequency)
 {
-	DictType type = dict->getType();
+	histogram(begin, end - begin, frequency);
+	frequency[HUFFMAN_EOF] = 1;
+}
 
-	switch (type)
-	{
-	case DICT_VALUE:
-	//if (DictValue<unsigned char> *dict_val = dynamic_cast<DictValue<unsigned char>*>(dict))
-	{
-		DictValue<unsigned char> *dict_val = static_cast<DictValue<unsigned char>*>(dict);
+void serialize_dictionary(OFileBitstream& s, const HuffmanTree& tree, unsigned short node);
 
-		map[dict_val->val] = new Bitstream(path);
-	} break;
-	case DICT_NODE:
-	//else if (DictNode<unsigned char> *dict_node = dynamic_cast<DictNode<unsigned char>*>(dict))
-	{
-		DictNode<unsigned char> *dict_node = static_cast<DictNode<unsigned char>*>(dict);
-		Bitstream path_copy = path;
-
-		path.push_back(false);
-		populate_reverse_map(map, dict_node->l, path);
-		path_copy.push_back(true);
-		populate_reverse_map(map, dict_node->r, path_copy);
-	} break;
-	case DICT_NONE_EOF:
-	//else // EOF
-	{
-		map[std::numeric_limits<unsigned char>::max() + 1] = new Bitstream(path);
-	} break;
-	}
-}
+// Builds a Huffman tree for the HUFFMAN_NUM_SYMBOLS counts, without
+// allocating. Symbols with a count of 0 are left out, and at least one
+// count must not be.
+void build_tree(const unsigned long long* frequency, HuffmanTree& tree);
 
-void serialize_dictionary(OFileBitstream& s, Dictionary<unsigned char> *dict)
-{
-	DictType type = dict->getType();
+} // namespace YURIKS_HUFFMAN_CPP
 
-	switch (type)
-	{
-	case DICT_VALUE:
-	{
-		DictValue<unsigned char> *dict_val = static_cast<DictValue<unsigned char>*>(dict);
-
-		s.push_back(false);
-		s.push_back(dict_val->val);
-		// To differentiate from EOF
-		if (dict_val->val == 0)
-			s.push_back(false);
-	} break;
-	case DICT_NODE:
-	{
-		DictNode<unsigned char> *dict_node = static_cast<DictNode<unsigned char>*>(dict);
+template <typename Iter>
+void build_huffman_tree(Iter& begin, const Iter& end, HuffmanTree& tree, Stats* stats)
+{
+	using namespace YURIKS_HUFFMAN_CPP;
 
-		s.push_back(true);
-		serialize_dictionary(s, dict_node->l);
-		serialize_dictionary(s, dict_node->r);
-	} break;
-	case DICT_NONE_EOF:
+	unsigned long long frequency[HUFFMAN_NUM_SYMBOLS];
 	{
-		s.push_back(false);
-		// EOF marker: 0 followed by bit 1
-		s.push_back(static_cast<unsigned char>(0));
-		s.push_back(true);
-	} break;
+		PhaseTimer timer(stats, PHASE_HISTOGRAM);
+		make_frequency(begin, end, frequency);
 	}
+
+	PhaseTimer timer(stats, PHASE_TREE);
+	build_tree(frequency, tree);
 }
 
-typedef std::pair<Dictionary<unsigned char>*, unsigned long> pairt;
-struct pairt_gt
+namespace YURIKS_HUFFMAN_CPP
 {
-	inline bool operator()(const pairt& a, const pairt& b)
-	{
-		return a.second > b.second;
-	}
-};
 
-} // namespace YURIKS_HUFFMAN_CPP
+// Symbols encoded between two progress reports
+static const unsigned int encode_chunk = 64 * 1024;
 
 template <typename Iter>
-Dictionary<unsigned char>* build_huffman_tree(Iter& begin, const Iter& end)
+void encode_stream(const EncodeTable& table, OFileBitstream& stream, Iter& begin, const Iter& end, unsigned long long size,
+	Stats* stats, unsigned long long* counts)
 {
-	using namespace YURIKS_HUFFMAN_CPP;
+	PhaseTimer timer(stats, PHASE_ENCODE);
 
-	static const unsigned char max_val = std::numeric_limits<unsigned char>::max();
+	const unsigned long long start_bits = stream.bitsWritten();
+	unsigned long long cur_pos = 0;
 
-	std::vector<unsigned long> frequency = make_frequency(begin, end);
-
-	std::priority_queue<pairt, std::vector<pairt>, pairt_gt> dict_queue;
-
-	for (unsigned int i = 0; i <= max_val; ++i)
+	// Write data
+	while (begin != end)
 	{
-		if (frequency[i] > 0)
+		unsigned int n = 0;
+		if (counts != 0)
 		{
-			dict_queue.push(pairt(new DictValue<unsigned char>(i), frequency[i]));
+			for (; n < encode_chunk && begin != end; ++n, ++begin)
+			{
+				unsigned char c = (unsigned char)*begin;
+				table.encode(stream, c);
+				++counts[c];
+			}
+		}
+		else
+		{
+			for (; n < encode_chunk && begin != end; ++n, ++begin)
+				table.encode(stream, (unsigned char)*begin);
 		}
+
+		cur_pos += n;
+		if (stats != 0)
+			stats->progress(cur_pos, size);
 	}
-	dict_queue.push(pairt(new Dictionary<unsigned char>, 1)); // Add EOF
 
-	while (dict_queue.size() > 1)
-	{
-		pairt a = dict_queue.top();
-		dict_queue.pop();
-		pairt b = dict_queue.top();
-		dict_queue.pop();
+	// Write EOF
+	table.encode(stream, HUFFMAN_EOF);
+	if (counts != 0)
+		++counts[HUFFMAN_EOF];
 
-		dict_queue.push(pairt(new DictNode<unsigned char>(a.first, b.first), a.second + b.second));
+	if (stats != 0)
+	{
+		stats->bytes_in += cur_pos;
+		stats->symbols += cur_pos;
+		stats->bits += stream.bitsWritten() - start_bits;
 	}
-	assert(std::accumulate(frequency.begin(), frequency.end(), 0) == dict_queue.top().second-1);
-
-	return dict_queue.top().first;
 }
 
-static const char spinner_chars[4] = {'|', '\\', '-', '/'};
+} // namespace YURIKS_HUFFMAN_CPP
 
 template <typename Iter>
-void huffman_compress(Dictionary<unsigned char>* tree, OFileBitstream& stream, Iter& begin, const Iter& end, unsigned long long size)
+void huffman_compress(const HuffmanTree& tree, OFileBitstream& stream, Iter& begin, const Iter& end, unsigned long long size,
+	Stats* stats, unsigned long long* counts)
 {
 	using namespace YURIKS_HUFFMAN_CPP;
 
-	static const unsigned char max_val = std::numeric_limits<unsigned char>::max();
+	const unsigned long long start_bits = stream.bitsWritten();
 
-	std::vector<Bitstream*> reverse_map(max_val+1+1, static_cast<Bitstream*>(0));
-	populate_reverse_map(reverse_map, tree, Bitstream());
+	PhaseTimer table_timer(stats, PHASE_TREE);
+	const EncodeTable table(tree);
+	table_timer.stop();
 
 	// Write dictionary
-	serialize_dictionary(stream, tree);
-
-	int progress = 1;
-	int spinner_pos = 0;
-	unsigned long cur_pos = 0;
-
-	// Write data
-	for (; begin != end; ++begin)
 	{
-		if (--progress == 0)
-		{
-			std::cerr << '\r' << spinner_chars[spinner_pos] << ' ' << (int)((float)cur_pos / size * 100) << '%' << std::flush;
-			if (++spinner_pos == 4)
-				spinner_pos = 0;
-
-			progress = 100000;
-		}
-
-		stream.push_back(*reverse_map[(unsigned char)*begin]);
-		++cur_pos;
+		PhaseTimer timer(stats, PHASE_HEADER);
+		serialize_dictionary(stream, tree, tree.root());
 	}
-	std::cerr << "\r  100%" << std::endl;
 
-	// Write EOF
-	stream.push_back(*reverse_map[max_val+1]);
+	encode_stream(table, stream, begin, end, size, stats, counts);
 
-	for (std::vector<Bitstream*>::iterator i = reverse_map.begin(); i != reverse_map.end(); ++i)
-		delete *i;
+	if (stats != 0)
+		stats->bytes_out += (stream.bitsWritten() - start_bits + 7) / 8;
 }
 
-void huffman_uncompress(IFileBitstream& stream, std::ostream& output, const Dictionary<unsigned char>* tree, unsigned long long size)
+template <typename Iter>
+void build_canonical_code(Iter& begin, const Iter& end, unsigned int max_length, unsigned char* lengths, Stats* stats)
 {
-	const Dictionary<unsigned char> *const root = tree;
-	const Dictionary<unsigned char>* cur = root;
+	using namespace YURIKS_HUFFMAN_CPP;
 
-	try
+	unsigned long long frequency[HUFFMAN_NUM_SYMBOLS];
 	{
-		int progress = 1;
-		int spinner_pos = 0;
-		unsigned long cur_pos = 0;
-
-		while (true)
-		{
-			// Isto eh uma otimizacao
-			DictType t = cur->getType();
-
-			switch (t)
-			{
-			case DICT_NODE:
-			{
-				const DictNode<unsigned char>* node = static_cast<const DictNode<unsigned char>*>(cur);
+		PhaseTimer timer(stats, PHASE_HISTOGRAM);
+		make_frequency(begin, end, frequency);
+	}
 
-				if (!stream.nextBit())
-					cur = node->l;
-				else
-					cur = node->r;
+	PhaseTimer timer(stats, PHASE_TREE);
+	build_code_lengths(frequency, max_length, lengths);
+}
 
-				++cur_pos;
-			} break;
-			case DICT_VALUE:
-			{
-				const DictValue<unsigned char>* val = static_cast<const DictValue<unsigned char>*>(cur);
+template <typename Iter>
+void huffman_compress_canonical(const unsigned char* lengths, OFileBitstream& stream, Iter& begin, const Iter& end, unsigned long long size,
+	Stats* stats, unsigned long long* counts)
+{
+	using namespace YURIKS_HUFFMAN_CPP;
 
-				if (--progress == 0)
-				{
-					std::cerr << '\r' << spinner_chars[spinner_pos] << ' ' << (int)((float)cur_pos / 8 / size * 100) << '%' << std::flush;
-					if (++spinner_pos == 4)
-						spinner_pos = 0;
+	const unsigned long long start_bits = stream.bitsWritten();
 
-					progress = 100000;
-				}
+	PhaseTimer table_timer(stats, PHASE_TREE);
+	const EncodeTable table(lengths);
+	table_timer.stop();
 
-				output.put((char)val->val);
-				cur = root;
-			} break;
-			case DICT_NONE_EOF:
-			{
-				// EOF
-				goto out_while;
-			} break;
-			}
-		}
-out_while:;
-		std::cerr << "\r  100%" << std::endl;
-	}
-	catch (std::ifstream::failure&)
 	{
-		std::cerr << "Erro durante a descompressao";
+		PhaseTimer timer(stats, PHASE_HEADER);
+		write_format(stream, FORMAT_CANONICAL);
+		write_code_lengths(stream, lengths);
 	}
-}
 
-Dictionary<unsigned char>* readNode(IFileBitstream& stream)
-{
-	if (stream.nextBit())
-	{
-		DictNode<unsigned char>* node = new DictNode<unsigned char>();
-		node->l = readNode(stream);
-		node->r = readNode(stream);
-		return node;
-	}
-	else
-	{
-		unsigned char val = stream.nextChar();
-		if (val == 0)
-			if (stream.nextBit() == true)
-				return new Dictionary<unsigned char>(); // EOF
-		return new DictValue<unsigned char>(val);
-	}
+	encode_stream(table, stream, begin, end, size, stats, counts);
+
+	if (stats != 0)
+		stats->bytes_out += (stream.bitsWritten() - start_bits + 7) / 8;
 }
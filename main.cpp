@@ -30,12 +30,105 @@
 #endif
 
 #include "huffman.h"
+#include "adaptive.h"
+#include "batch.h"
 #include "bitstream.h"
 #include "dump_tree.h"
+#include "canonical.h"
+#include "container.h"
+#include "file_io.h"
+#include "histogram.h"
+#include "pipeline.h"
+#include "sample.h"
+#include "shared_table.h"
+#include "static_table.h"
+#include "stats.h"
+#include "thread_pool.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <string>
+#include <vector>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+// Parses a byte count with an optional K, M or G suffix
+static unsigned long long parse_size(const char* s)
+{
+	char* suffix;
+	unsigned long long size = std::strtoull(s, &suffix, 10);
+
+	if (*suffix == 'K' || *suffix == 'k')
+		size <<= 10;
+	else if (*suffix == 'M' || *suffix == 'm')
+		size <<= 20;
+	else if (*suffix == 'G' || *suffix == 'g')
+		size <<= 30;
+
+	return size;
+}
+
+// Overwrites the same line with the percentage done
+static void print_progress(unsigned long long done, unsigned long long total, void*)
+{
+	if (total != 0)
+		std::cerr << '\r' << done * 100 / total << '%' << std::flush;
+	else
+		std::cerr << '\r' << (done >> 20) << " MB" << std::flush;
+}
+
+// How much --sample cost, against the exact counts gathered while coding
+static void print_sample_loss(unsigned long long sampled, unsigned long long size, const unsigned long long* counts,
+	const EncodeTable& code, unsigned int max_length)
+{
+	std::cerr << std::fixed << std::setprecision(2) << "Amostra de " << sampled / 1e6 << " MB ("
+		<< (size != 0 ? 100.0 * sampled / size : 100.0) << "%), perda estimada de "
+		<< 100 * code_loss(counts, code, max_length) << "% em relacao ao histograma exato" << std::endl;
+}
+
+// Counts the bytes of a mapped input, split between `threads` threads (0
+// for one per core) when it's large enough
+static void count_bytes(const unsigned char* data, size_t size, unsigned int threads, unsigned long long* counts)
+{
+	if (threads == 1)
+	{
+		histogram(data, size, counts);
+		return;
+	}
+
+	ThreadPool pool(threads);
+	histogram_parallel(data, size, counts, pool);
+}
+
+// Keeps the --table tables registered until main returns, whichever way it
+// does, and unregisters them before the vector holding them goes away
+class TableRegistration
+{
+public:
+	explicit TableRegistration(const std::vector<SharedTable>& tables)
+		: tables(tables)
+	{
+		for (size_t i = 0; i < tables.size(); ++i)
+			register_shared_table(&tables[i]);
+	}
+
+	~TableRegistration()
+	{
+		for (size_t i = 0; i < tables.size(); ++i)
+			unregister_shared_table(&tables[i]);
+	}
+
+private:
+	TableRegistration(const TableRegistration&);
+	TableRegistration& operator=(const TableRegistration&);
+
+	const std::vector<SharedTable>& tables;
+};
 
 int main(int argc, char *argv[])
 {
@@ -43,76 +136,624 @@ int main(int argc, char *argv[])
 	_CrtSetDbgFlag ( _CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF );
 #endif
 
+	// std::cin is read in bulk when compressing from a pipe
+	std::ios::sync_with_stdio(false);
+
 
-	if (argc != 4)
+	if (argc < 4)
 	{
 		std::cerr << "Invalid number of arguments." << std::endl;
-		std::cerr << "Usage: Huffman.exe -c/-u <infile> <outfile>" << std::endl;
+		std::cerr << "Usage: Huffman.exe -c/-u [options] <infile> <outfile>" << std::endl;
+		std::cerr << "       Huffman.exe -c/-u --batch [options] <list|directory> <outdir>" << std::endl;
+		std::cerr << "       Huffman.exe --train [--max-code-length=N] <samples> <tablefile>" << std::endl;
+		std::cerr << "       Huffman.exe --make-header [--name=NAME] <tablefile> <header>" << std::endl;
+		std::cerr << "<infile> and <outfile> can be - for standard input and output." << std::endl;
+		std::cerr << "--batch codes every file in a directory, or named in a list with one file per" << std::endl;
+		std::cerr << "line (- for standard input), into <outdir> in one process. Only for blocks." << std::endl;
+		std::cerr << "--make-header writes a table as a C++ header for static_table.h, as the struct" << std::endl;
+		std::cerr << "NAME (default BuiltinTable)." << std::endl;
+		std::cerr << "Options for -c:" << std::endl;
+		std::cerr << "  --block-size=N[K|M]    Compress independent blocks of N bytes (default 1M)" << std::endl;
+		std::cerr << "  --threads=N            Worker threads, 0 for one per core (default 0)" << std::endl;
+		std::cerr << "  --max-code-length=N    Longest code allowed, " << HUFFMAN_MIN_CODE_LENGTH_LIMIT
+			<< " to " << HUFFMAN_MAX_CODE_LENGTH << std::endl;
+		std::cerr << "  --streams=N            Interleaved streams per block, 1 to " << BLOCK_MAX_STREAMS
+			<< " (default " << BLOCK_DEFAULT_STREAMS << ")" << std::endl;
+		std::cerr << "  --contexts=N           Code bytes with up to N codes picked by the byte before," << std::endl;
+		std::cerr << "                         2 to " << CONTEXT_MAX_GROUPS << ", where it makes blocks smaller" << std::endl;
+		std::cerr << "  --canonical            Write a single canonical code stream instead of blocks" << std::endl;
+		std::cerr << "  --tree                 Write the original single tree format" << std::endl;
+		std::cerr << "  --sample=F             Make the --canonical or --tree code from about F (0 to 1)" << std::endl;
+		std::cerr << "                         of the input, read in chunks spread over it" << std::endl;
+		std::cerr << "  --adaptive[=N]         Code in one pass, rebuilding the code every N bytes" << std::endl;
+		std::cerr << "                         (a power of two, default " << (1 << ADAPTIVE_DEFAULT_INTERVAL_BITS)
+			<< "). For live streams." << std::endl;
+		std::cerr << "  --table=FILE           Code every block with a table made by --train" << std::endl;
+		std::cerr << "Options for -u:" << std::endl;
+		std::cerr << "  --threads=N            Worker threads, 0 for one per core (default 0)" << std::endl;
+		std::cerr << "  --offset=N[K|M|G]      Only extract the data starting at byte N (block files)" << std::endl;
+		std::cerr << "  --length=N[K|M|G]      Only extract N bytes of data (block files)" << std::endl;
+		std::cerr << "  --table=FILE           Table needed by the blocks, can be given more than once" << std::endl;
+		std::cerr << "Options for both:" << std::endl;
+		std::cerr << "  --progress             Show how much of the input is done" << std::endl;
+		std::cerr << "  --pipeline             Read and write on threads of their own, overlapping" << std::endl;
+		std::cerr << "                         the I/O with coding" << std::endl;
+		std::cerr << "  --stats=json           Print timings and counters to stderr when done" << std::endl;
+
+		return 1;
+	}
+
+	const char* in_name = argv[argc-2];
+	const char* out_name = argv[argc-1];
+
+	HuffmanFormat format = FORMAT_BLOCKS;
+	ContainerOptions options;
+	bool partial = false;
+	bool batch = false;
+	bool pipeline = false;
+	bool show_progress = false;
+	bool show_stats = false;
+	unsigned long long range_offset = 0;
+	unsigned long long range_length = ~0ULL;
+	std::vector<std::string> table_names;
+	unsigned int adaptive_bits = ADAPTIVE_DEFAULT_INTERVAL_BITS;
+	unsigned int adaptive_max_code_length = ADAPTIVE_DEFAULT_MAX_CODE_LENGTH;
+	double sample_fraction = 1;
+	std::string header_name = "BuiltinTable";
+
+	for (int i = 2; i < argc-2; ++i)
+	{
+		std::string opt(argv[i]);
+
+		if (opt == "--canonical")
+		{
+			format = FORMAT_CANONICAL;
+		}
+		else if (opt == "--tree")
+		{
+			format = FORMAT_TREE;
+		}
+		else if (opt == "--adaptive" || opt.compare(0, 11, "--adaptive=") == 0)
+		{
+			format = FORMAT_ADAPTIVE;
+
+			if (opt.size() > 10)
+			{
+				unsigned long long interval = parse_size(opt.c_str() + 11);
+
+				adaptive_bits = 0;
+				while ((1ULL << adaptive_bits) < interval)
+					++adaptive_bits;
+
+				if ((1ULL << adaptive_bits) != interval ||
+					adaptive_bits < ADAPTIVE_MIN_INTERVAL_BITS || adaptive_bits > ADAPTIVE_MAX_INTERVAL_BITS)
+				{
+					std::cerr << "Invalid rebuild interval: " << opt.c_str() + 11 << std::endl;
+					return 1;
+				}
+			}
+		}
+		else if (opt.compare(0, 18, "--max-code-length=") == 0)
+		{
+			options.block.max_code_length = std::atoi(opt.c_str() + 18);
+			adaptive_max_code_length = options.block.max_code_length;
+
+			if (options.block.max_code_length < HUFFMAN_MIN_CODE_LENGTH_LIMIT || options.block.max_code_length > HUFFMAN_MAX_CODE_LENGTH)
+			{
+				std::cerr << "Invalid maximum code length: " << opt.c_str() + 18 << std::endl;
+				return 1;
+			}
+		}
+		else if (opt.compare(0, 13, "--block-size=") == 0)
+		{
+			unsigned long long block_size = parse_size(opt.c_str() + 13);
+
+			if (block_size < CONTAINER_MIN_BLOCK_SIZE || block_size > CONTAINER_MAX_BLOCK_SIZE)
+			{
+				std::cerr << "Invalid block size: " << opt.c_str() + 13 << std::endl;
+				return 1;
+			}
+			options.block_size = static_cast<size_t>(block_size);
+		}
+		else if (opt.compare(0, 10, "--streams=") == 0)
+		{
+			options.block.streams = std::atoi(opt.c_str() + 10);
+
+			if (options.block.streams < 1 || options.block.streams > BLOCK_MAX_STREAMS)
+			{
+				std::cerr << "Invalid stream count: " << opt.c_str() + 10 << std::endl;
+				return 1;
+			}
+		}
+		else if (opt.compare(0, 11, "--contexts=") == 0)
+		{
+			options.block.context_groups = std::atoi(opt.c_str() + 11);
+
+			if (options.block.context_groups < 2 || options.block.context_groups > CONTEXT_MAX_GROUPS)
+			{
+				std::cerr << "Invalid context count: " << opt.c_str() + 11 << std::endl;
+				return 1;
+			}
+		}
+		else if (opt.compare(0, 10, "--threads=") == 0)
+		{
+			options.threads = std::atoi(opt.c_str() + 10);
+		}
+		else if (opt.compare(0, 9, "--sample=") == 0)
+		{
+			sample_fraction = std::atof(opt.c_str() + 9);
 
+			if (!(sample_fraction > 0 && sample_fraction <= 1))
+			{
+				std::cerr << "Invalid sample fraction: " << opt.c_str() + 9 << std::endl;
+				return 1;
+			}
+		}
+		else if (opt.compare(0, 7, "--name=") == 0)
+		{
+			header_name = opt.substr(7);
+
+			if (header_name.empty() || std::isdigit(static_cast<unsigned char>(header_name[0])) ||
+				header_name.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_") != std::string::npos)
+			{
+				std::cerr << "Invalid name: " << header_name << std::endl;
+				return 1;
+			}
+		}
+		else if (opt == "--batch")
+		{
+			batch = true;
+		}
+		else if (opt == "--pipeline")
+		{
+			pipeline = true;
+		}
+		else if (opt == "--progress")
+		{
+			show_progress = true;
+		}
+		else if (opt == "--stats=json")
+		{
+			show_stats = true;
+		}
+		else if (opt.compare(0, 9, "--offset=") == 0)
+		{
+			partial = true;
+			range_offset = parse_size(opt.c_str() + 9);
+		}
+		else if (opt.compare(0, 9, "--length=") == 0)
+		{
+			partial = true;
+			range_length = parse_size(opt.c_str() + 9);
+		}
+		else if (opt.compare(0, 8, "--table=") == 0)
+		{
+			table_names.push_back(opt.substr(8));
+		}
+		else
+		{
+			std::cerr << "Unknown option " << opt << std::endl;
+			return 1;
+		}
+	}
+
+	// Compression uses the last table given
+	std::vector<SharedTable> tables;
+	for (size_t i = 0; i < table_names.size(); ++i)
+	{
+		std::ifstream table_file(table_names[i].c_str(), std::ios::in | std::ios::binary);
+		if (!table_file)
+		{
+			std::cerr << "Couldn't open " << table_names[i] << std::endl;
+			return 2;
+		}
+
+		try
+		{
+			tables.push_back(read_shared_table(table_file));
+		}
+		catch (std::ios_base::failure& e)
+		{
+			std::cerr << "Couldn't read " << table_names[i] << ": " << e.what() << std::endl;
+			return 4;
+		}
+	}
+
+	if (!tables.empty() && format != FORMAT_BLOCKS)
+	{
+		std::cerr << "--table can't be used with --canonical, --tree or --adaptive" << std::endl;
 		return 1;
 	}
 
-	std::ifstream in_file(argv[2], std::ios::in | std::ios::binary);
-	if (!in_file)
+	// Registered once the vector is done growing
+	TableRegistration registration(tables);
+	if (!tables.empty())
+		options.block.table_id = tables.back().id();
+
+	// The block formats only read their input once anyway
+	const bool sampling = sample_fraction < 1;
+	if (sampling && format != FORMAT_CANONICAL && format != FORMAT_TREE)
+	{
+		std::cerr << "--sample only applies to --canonical and --tree" << std::endl;
+		return 1;
+	}
+
+	// Nothing is measured unless asked for
+	Stats stats_data;
+	Stats* stats = 0;
+	if (show_progress || show_stats)
+		stats = &stats_data;
+	if (show_progress)
+		stats_data.setProgress(print_progress, 0, 4 * 1024 * 1024);
+	options.block.stats = stats;
+
+	std::string arg(argv[1]);
+
+	if (batch)
+	{
+		if ((arg != "-c" && arg != "-u") || format != FORMAT_BLOCKS || partial)
+		{
+			std::cerr << "--batch only compresses in blocks and can't be used with --offset or --length" << std::endl;
+			return 1;
+		}
+
+		BatchOptions batch_options;
+		batch_options.container = options;
+		batch_options.decompress = arg == "-u";
+
+		std::vector<BatchFile> files;
+		try
+		{
+			files = list_batch(in_name, out_name, batch_options.decompress);
+		}
+		catch (std::ios_base::failure& e)
+		{
+			std::cerr << "Couldn't read " << in_name << ": " << e.what() << std::endl;
+			return 4;
+		}
+
+		std::cerr << (batch_options.decompress ? "Descomprimindo " : "Comprimindo ") << files.size() << " arquivos..." << std::endl;
+		BatchResult result = run_batch(files, batch_options, std::cerr);
+
+		if (show_progress)
+			std::cerr << std::endl;
+		std::cerr << std::fixed << std::setprecision(1)
+			<< result.files - result.failed << " arquivos, " << result.bytes_in / 1e6 << " MB -> " << result.bytes_out / 1e6
+			<< " MB em " << result.seconds << " s (" << (result.seconds > 0 ? result.bytes_in / 1e6 / result.seconds : 0.0)
+			<< " MB/s)" << std::endl;
+		if (result.failed != 0)
+			std::cerr << result.failed << " arquivos com erro" << std::endl;
+		if (show_stats)
+			stats_data.writeJson(std::cerr);
+
+		return result.failed != 0 ? 4 : 0;
+	}
+
+	// Regular files are mapped and coded in place. The stream is still
+	// used to detect the format and for inputs that can't be mapped.
+	// "-" is standard input or output.
+	const bool in_stdin = std::strcmp(in_name, "-") == 0;
+	InputFile in_map;
+	std::ifstream in_fstream;
+	if (!in_stdin)
+		in_fstream.open(in_name, std::ios::in | std::ios::binary);
+	std::istream& in_file = in_stdin ? std::cin : in_fstream;
+
+	if (!in_file || !(in_stdin ? in_map.openStdin() : in_map.open(in_name)))
 	{
-		std::cerr << "Couldn't open " << argv[2] << std::endl;
+		std::cerr << "Couldn't open " << in_name << std::endl;
 		return 2;
 	}
 
-	std::ofstream out_file(argv[3], std::ios::out | std::ios::binary | std::ios::trunc);
-	if (!out_file)
+	OutputFileBuf out_buf;
+	if (!(std::strcmp(out_name, "-") == 0 ? out_buf.openStdout() : out_buf.open(out_name)))
 	{
-		std::cerr << "Couldn't open " << argv[3] << std::endl;
+		std::cerr << "Couldn't open " << out_name << std::endl;
 		return 3;
 	}
+	// A writer thread drains whatever is written through out_file
+	std::unique_ptr<PipelineOutputBuf> out_pipe;
+	if (pipeline)
+		out_pipe.reset(new PipelineOutputBuf(&out_buf, stats));
+	std::ostream out_file(pipeline ? static_cast<std::streambuf*>(out_pipe.get()) : &out_buf);
 
-	std::string arg(argv[1]);
+	// And a reader thread reads ahead for the coders that read their input
+	// once, front to back
+	std::unique_ptr<PipelineInputBuf> in_pipe;
+	std::istream piped_in(0);
+	std::istream* sequential_in = &in_file;
+	if (pipeline && arg == "-c" && (format == FORMAT_ADAPTIVE || (format == FORMAT_BLOCKS && !in_map.mapped())))
+	{
+		in_pipe.reset(new PipelineInputBuf(in_file.rdbuf(), stats));
+		piped_in.rdbuf(in_pipe.get());
+		sequential_in = &piped_in;
+	}
+
+	// What the single code formats really coded, for --sample to compare with
+	unsigned long long exact_data[HUFFMAN_NUM_SYMBOLS] = { 0 };
+	unsigned long long* exact_counts = sampling ? exact_data : 0;
+
+	if (arg == "-c" && format == FORMAT_BLOCKS)
+	{
+		std::cerr << "Comprimindo arquivo..." << std::endl;
+		if (in_map.mapped())
+			compress_blocks(in_map.data(), in_map.size(), out_file, options);
+		else
+			compress_blocks(*sequential_in, out_file, options);
+	}
+	else if (arg == "-c" && format == FORMAT_ADAPTIVE)
+	{
+		std::cerr << "Comprimindo arquivo..." << std::endl;
+		OFileBitstream stream(out_file);
+		write_format(stream, FORMAT_ADAPTIVE);
+		huffman_compress_adaptive(*sequential_in, stream, adaptive_bits, adaptive_max_code_length, stats);
+	}
+	else if (arg == "-c" && in_map.mapped())
+	{
+		OFileBitstream stream(out_file);
+		const unsigned char* in_begin = in_map.data();
+		const unsigned char* in_end = in_begin + in_map.size();
+
+		unsigned long long frequency[HUFFMAN_NUM_SYMBOLS];
+		unsigned long long sampled = 0;
+		if (sampling)
+		{
+			sampled = sample_frequency(in_begin, in_map.size(), sample_fraction, frequency, stats);
+		}
+		else
+		{
+			PhaseTimer timer(stats, PHASE_HISTOGRAM);
+			count_bytes(in_begin, in_map.size(), options.threads, frequency);
+			frequency[HUFFMAN_EOF] = 1;
+		}
+
+		if (format == FORMAT_CANONICAL)
+		{
+			std::cerr << "Construindo codigo..." << std::endl;
+			unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+			build_canonical_code(frequency, options.block.max_code_length, lengths, stats);
+			std::cerr << "Comprimindo arquivo..." << std::endl;
+			huffman_compress_canonical(lengths, stream, in_begin, in_end, in_map.size(), stats, exact_counts);
+
+			if (sampling)
+				print_sample_loss(sampled, in_map.size(), exact_counts, EncodeTable(lengths), options.block.max_code_length);
+		}
+		else
+		{
+			std::cerr << "Construindo arvore..." << std::endl;
+			HuffmanTree tree;
+			build_huffman_tree(frequency, tree, stats);
+			std::cerr << "Comprimindo arquivo..." << std::endl;
+			huffman_compress(tree, stream, in_begin, in_end, in_map.size(), stats, exact_counts);
 
-	if (arg == "-c")
+			if (sampling)
+				print_sample_loss(sampled, in_map.size(), exact_counts, EncodeTable(tree), EncodeTable::max_code_length);
+		}
+	}
+	else if (arg == "-c" && !in_map.seekable())
+	{
+		std::cerr << "--canonical and --tree read the input twice, so they can't compress from a pipe" << std::endl;
+		return 1;
+	}
+	else if (arg == "-c")
 	{
 		OFileBitstream stream(out_file);
+
+		unsigned long long frequency[HUFFMAN_NUM_SYMBOLS];
+		unsigned long long sampled = 0;
+		if (sampling)
+		{
+			try
+			{
+				sampled = sample_frequency(in_file, in_map.size(), sample_fraction, frequency, stats);
+			}
+			catch (std::ios_base::failure& e)
+			{
+				std::cerr << "Couldn't read " << in_name << ": " << e.what() << std::endl;
+				return 4;
+			}
+		}
+
 		std::istreambuf_iterator<char> in_iter(in_file);
 
-		std::cerr << "Construindo arvore..." << std::endl;
-		Dictionary<unsigned char>* tree = build_huffman_tree(in_iter, std::istreambuf_iterator<char>());
-		std::ifstream::pos_type size = in_file.tellg();
-		in_file.seekg(0);
-		std::cerr << "Comprimindo arquivo..." << std::endl;
-		huffman_compress(tree, stream, in_iter, std::istreambuf_iterator<char>(), size);
-		delete tree;
-	} 
+		if (format == FORMAT_CANONICAL)
+		{
+			std::cerr << "Construindo codigo..." << std::endl;
+			unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+			if (sampling)
+				build_canonical_code(frequency, options.block.max_code_length, lengths, stats);
+			else
+				build_canonical_code(in_iter, std::istreambuf_iterator<char>(), options.block.max_code_length, lengths, stats);
+			in_file.seekg(0);
+			std::cerr << "Comprimindo arquivo..." << std::endl;
+			huffman_compress_canonical(lengths, stream, in_iter, std::istreambuf_iterator<char>(), in_map.size(), stats, exact_counts);
+
+			if (sampling)
+				print_sample_loss(sampled, in_map.size(), exact_counts, EncodeTable(lengths), options.block.max_code_length);
+		}
+		else
+		{
+			std::cerr << "Construindo arvore..." << std::endl;
+			HuffmanTree tree;
+			if (sampling)
+				build_huffman_tree(frequency, tree, stats);
+			else
+				build_huffman_tree(in_iter, std::istreambuf_iterator<char>(), tree, stats);
+			in_file.seekg(0);
+			std::cerr << "Comprimindo arquivo..." << std::endl;
+			huffman_compress(tree, stream, in_iter, std::istreambuf_iterator<char>(), in_map.size(), stats, exact_counts);
+
+			if (sampling)
+				print_sample_loss(sampled, in_map.size(), exact_counts, EncodeTable(tree), EncodeTable::max_code_length);
+		}
+	}
 	else if (arg == "-u")
 	{
-		in_file.seekg(0, std::ios::end);
-		unsigned long long size = in_file.tellg();
-		in_file.seekg(0);
+		// Pipes are decoded in one pass, without knowing the size
+		unsigned long long size = in_map.seekable() ? in_map.size() : 0;
 
-		IFileBitstream istream(in_file);
-		std::cerr << "Lendo arvore..." << std::endl;
-		Dictionary<unsigned char>* tree = readNode(istream);
-		size -= in_file.tellg();
-		std::cerr << "Descomprimindo arquivo..." << std::endl;
-		huffman_uncompress(istream, out_file, tree, size);
-		delete tree;
+		try
+		{
+			HuffmanFormat in_format = read_format(in_file);
+			// The bitstream below starts after the header, and so does the
+			// progress of the single stream formats
+			if (size != 0 && in_format != FORMAT_TREE)
+				size -= FORMAT_HEADER_SIZE;
+
+			// Not for live streams, whose reader could be left waiting for
+			// input after the end
+			if (pipeline && in_format != FORMAT_ADAPTIVE && !(in_format == FORMAT_BLOCKS && in_map.seekable()))
+			{
+				in_pipe.reset(new PipelineInputBuf(in_file.rdbuf(), stats));
+				piped_in.rdbuf(in_pipe.get());
+				sequential_in = &piped_in;
+			}
+
+			// Live streams are decoded as they arrive
+			IFileBitstream istream(*sequential_in, in_format == FORMAT_ADAPTIVE);
+
+			if (partial && in_format != FORMAT_BLOCKS)
+			{
+				std::cerr << "--offset and --length need a file compressed in blocks" << std::endl;
+				return 1;
+			}
+			if (partial && !in_map.seekable())
+			{
+				std::cerr << "--offset and --length can't be used when reading from a pipe" << std::endl;
+				return 1;
+			}
+
+			if (in_format == FORMAT_BLOCKS && in_map.mapped())
+			{
+				std::cerr << "Descomprimindo arquivo..." << std::endl;
+				ContainerIndex index = read_container_index(in_map.data(), in_map.size());
+
+				unsigned long long length = 0;
+				if (range_offset < index.raw_size)
+					length = std::min(range_length, index.raw_size - range_offset);
+
+				// The output size is known, so decode straight into the file
+				unsigned char* out_data = out_buf.map(length);
+				if (out_data != 0)
+					decompress_range(in_map.data(), index, range_offset, length, out_data, options.threads, stats);
+				else
+					decompress_range(in_file, out_file, index, range_offset, length, options.threads, stats);
+			}
+			else if (in_format == FORMAT_BLOCKS && in_map.seekable())
+			{
+				std::cerr << "Descomprimindo arquivo..." << std::endl;
+				ContainerIndex index = read_container_index(in_file);
+				decompress_range(in_file, out_file, index, range_offset, range_length, options.threads, stats);
+			}
+			else if (in_format == FORMAT_BLOCKS)
+			{
+				std::cerr << "Descomprimindo arquivo..." << std::endl;
+				decompress_blocks(*sequential_in, out_file, options.threads, stats);
+			}
+			else if (in_format == FORMAT_ADAPTIVE)
+			{
+				std::cerr << "Descomprimindo arquivo..." << std::endl;
+				huffman_uncompress_adaptive(istream, out_file, stats);
+			}
+			else if (in_format == FORMAT_CANONICAL)
+			{
+				if (size != 0)
+					size -= istream.bytesConsumed();
+				std::cerr << "Descomprimindo arquivo..." << std::endl;
+				huffman_uncompress_canonical(istream, out_file, size, stats);
+			}
+			else
+			{
+				std::cerr << "Lendo arvore..." << std::endl;
+				HuffmanTree tree;
+				readNode(istream, tree, stats);
+				if (size != 0)
+					size -= istream.bytesConsumed();
+				std::cerr << "Descomprimindo arquivo..." << std::endl;
+				huffman_uncompress(istream, out_file, tree, size, stats);
+			}
+		}
+		catch (std::ios_base::failure& e)
+		{
+			std::cerr << "Couldn't read " << in_name << ": " << e.what() << std::endl;
+			return 4;
+		}
+	}
+	else if (arg == "--train")
+	{
+		unsigned long long counts[HISTOGRAM_SIZE];
+
+		if (in_map.mapped())
+		{
+			count_bytes(in_map.data(), in_map.size(), options.threads, counts);
+		}
+		else
+		{
+			std::fill(counts, counts + HISTOGRAM_SIZE, 0ULL);
+
+			std::vector<char> buf(1024 * 1024);
+			while (in_file.read(&buf[0], buf.size()) || in_file.gcount() > 0)
+			{
+				unsigned long long part[HISTOGRAM_SIZE];
+				histogram(reinterpret_cast<const unsigned char*>(&buf[0]), static_cast<size_t>(in_file.gcount()), part);
+				for (int i = 0; i < HISTOGRAM_SIZE; ++i)
+					counts[i] += part[i];
+			}
+		}
+
+		SharedTable table(counts, options.block.max_code_length);
+		write_shared_table(out_file, table);
+		std::cerr << "Tabela " << std::hex << table.id() << std::dec << std::endl;
+	}
+	else if (arg == "--make-header")
+	{
+		try
+		{
+			write_static_table(out_file, read_shared_table(in_file), header_name);
+		}
+		catch (std::ios_base::failure& e)
+		{
+			std::cerr << "Couldn't read " << in_name << ": " << e.what() << std::endl;
+			return 4;
+		}
 	}
 	else if (arg == "--make-tree")
 	{
 		std::istreambuf_iterator<char> in_iter(in_file);
 
-		Dictionary<unsigned char>* tree = build_huffman_tree(in_iter, std::istreambuf_iterator<char>());
+		HuffmanTree tree;
+		build_huffman_tree(in_iter, std::istreambuf_iterator<char>(), tree);
 		print_huffman_tree(tree, out_file);
-		delete tree;
 	}
 	else if (arg == "--read-tree")
 	{
 		IFileBitstream istream(in_file);
-		Dictionary<unsigned char>* tree = readNode(istream);
+		HuffmanTree tree;
+
+		try
+		{
+			readNode(istream, tree);
+		}
+		catch (std::ios_base::failure& e)
+		{
+			std::cerr << "Couldn't read " << in_name << ": " << e.what() << std::endl;
+			return 4;
+		}
 		print_huffman_tree(tree, out_file);
-		delete tree;
 	}
 
-	out_file.close();
-	in_file.close();
+	out_file.flush();
+	if (!out_file || (out_pipe && !out_pipe->close()) || !out_buf.close())
+	{
+		std::cerr << "Couldn't write " << out_name << std::endl;
+		return 5;
+	}
+	in_fstream.close();
+
+	if (show_progress)
+		std::cerr << std::endl;
+	if (show_stats)
+		stats_data.writeJson(std::cerr);
 
 
 	return 0;
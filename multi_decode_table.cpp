@@ -0,0 +1,148 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "multi_decode_table.h"
+#include "canonical.h"
+
+#include <algorithm>
+#include <cmath>
+
+const int MultiDecodeTable::max_bits;
+const int MultiDecodeTable::max_symbols;
+const int MultiDecodeTable::default_bits;
+
+MultiDecodeTable::MultiDecodeTable()
+	: bits(0), symbols(0)
+{
+}
+
+bool MultiDecodeTable::build(const unsigned char* lengths, int bits, int symbols)
+{
+	unsigned int canonical[HUFFMAN_NUM_SYMBOLS];
+	canonical_codes(lengths, canonical);
+
+	codes.clear();
+	for (unsigned int i = 0; i < HUFFMAN_EOF; ++i)
+	{
+		if (lengths[i] != 0 && lengths[i] <= bits)
+		{
+			Code c = { canonical[i], static_cast<unsigned char>(i), lengths[i] };
+			codes.push_back(c);
+		}
+	}
+
+	return fillAll(bits, symbols);
+}
+
+bool MultiDecodeTable::build(const HuffmanTree& tree, int bits, int symbols)
+{
+	// Only codes that fit in the index matter
+	this->bits = std::min(bits, max_bits);
+	codes.clear();
+	collect(tree, tree.root(), 0, 0);
+
+	return fillAll(bits, symbols);
+}
+
+bool MultiDecodeTable::shorter(const Code& a, const Code& b)
+{
+	return a.length < b.length;
+}
+
+void MultiDecodeTable::collect(const HuffmanTree& tree, unsigned short node, int depth, unsigned int code)
+{
+	const DictEntry& dict = tree[node];
+
+	if (dict.type == DICT_NODE)
+	{
+		if (depth < bits)
+		{
+			collect(tree, dict.l, depth+1, code << 1);
+			collect(tree, dict.r, depth+1, (code << 1) | 1);
+		}
+	}
+	else if (dict.type == DICT_VALUE && depth != 0)
+	{
+		Code c = { code, dict.val, static_cast<unsigned char>(depth) };
+		codes.push_back(c);
+	}
+}
+
+bool MultiDecodeTable::fillAll(int bits, int symbols)
+{
+	this->bits = std::min(bits, max_bits);
+	this->symbols = std::min(symbols, max_symbols);
+	entries.clear();
+
+	std::sort(codes.begin(), codes.end(), shorter);
+
+	// A code of length l is used about 2^-l of the time, so this is roughly
+	// the average code length, taking all longer codes as bits+1 long.
+	// Lookups have to resolve a bit over two codes on average to make up for
+	// storing several symbols at once.
+	double average = 0;
+	double rest = 1;
+	for (size_t i = 0; i < codes.size(); ++i)
+	{
+		double p = std::ldexp(1.0, -codes[i].length);
+		average += p * codes[i].length;
+		rest -= p;
+	}
+	average += rest * (this->bits + 1);
+
+	if (this->bits <= 0 || this->symbols < 2 || 2 * average + 1 > this->bits)
+	{
+		this->bits = 0;
+		return false;
+	}
+
+	MultiDecodeEntry none = { { 0, 0, 0, 0 }, 0, 0 };
+	entries.assign(size_t(1) << this->bits, none);
+	fill(0, none);
+
+	return true;
+}
+
+// Adds every code that still fits after the ones in entry, whose bits are
+// prefix. Each fills the whole range of indices that start with it, and the
+// codes after it then overwrite parts of that range.
+void MultiDecodeTable::fill(size_t prefix, const MultiDecodeEntry& entry)
+{
+	for (size_t i = 0; i < codes.size(); ++i)
+	{
+		const Code& c = codes[i];
+		int free_bits = bits - entry.length - c.length;
+		if (free_bits < 0)
+			break;
+
+		MultiDecodeEntry e = entry;
+		e.symbols[e.count++] = c.symbol;
+		e.length = static_cast<unsigned char>(e.length + c.length);
+
+		size_t code = (prefix << c.length) | c.code;
+		std::fill_n(entries.begin() + (code << free_bits), size_t(1) << free_bits, e);
+
+		if (e.count < symbols)
+			fill(code, e);
+	}
+}
@@ -0,0 +1,125 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_MULTI_DECODE_TABLE_H
+#define YURIKS_MULTI_DECODE_TABLE_H
+
+#include "decode_table.h"
+#include "dictionary.h"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// One slot of a MultiDecodeTable: the codes that start at this index and
+// fit in it, in stream order.
+struct MultiDecodeEntry
+{
+	unsigned char symbols[4];
+	// 0 if the first code is longer than the index, or isn't a byte, so the
+	// single-symbol table has to resolve it
+	unsigned char count;
+	// Bits taken by the count codes
+	unsigned char length;
+};
+
+// Lookup table that resolves several short codes at once. It is indexed by
+// the next `bits` bits of input, and each entry holds every whole code that
+// fits in them, up to `symbols` of them. Longer codes, EOF and invalid
+// codes fall back to the DecodeTable of the same code, so this only speeds
+// up the common case of low-entropy data.
+//
+// Building writes at most symbols * 2^bits entries, whatever the code.
+class MultiDecodeTable
+{
+public:
+	static const int max_bits = 12;
+	static const int max_symbols = 4;
+	static const int default_bits = 11;
+
+	// Empty table, build() must be called before decoding.
+	MultiDecodeTable();
+
+	// Rebuilds the table for the canonical code with these code lengths,
+	// reusing the memory of the previous one. Returns false and leaves the
+	// table empty if an average lookup wouldn't resolve two codes, since
+	// decoding with the single-symbol table is faster then.
+	bool build(const unsigned char* lengths, int bits = default_bits, int symbols = max_symbols);
+	// Same, for the code of a tree
+	bool build(const HuffmanTree& tree, int bits = default_bits, int symbols = max_symbols);
+
+	bool empty() const;
+
+	// Decodes the next one or more symbols to out, which must have room for
+	// max_symbols bytes, and sets count to how many were decoded. Returns
+	// the value of a code resolved by fallback, which may be HUFFMAN_EOF or
+	// invalid, and 0 otherwise.
+	template <typename Reader>
+	unsigned int decode(Reader& stream, const DecodeTable& fallback, unsigned char* out, unsigned int& count) const;
+
+private:
+	struct Code
+	{
+		unsigned int code;
+		unsigned char symbol;
+		unsigned char length;
+	};
+
+	static bool shorter(const Code& a, const Code& b);
+
+	void collect(const HuffmanTree& tree, unsigned short node, int depth, unsigned int code);
+	bool fillAll(int bits, int symbols);
+	void fill(size_t prefix, const MultiDecodeEntry& entry);
+
+	std::vector<MultiDecodeEntry> entries;
+	// Byte codes no longer than the index, by length
+	std::vector<Code> codes;
+	int bits;
+	int symbols;
+};
+
+inline bool MultiDecodeTable::empty() const
+{
+	return entries.empty();
+}
+
+template <typename Reader>
+inline unsigned int MultiDecodeTable::decode(Reader& stream, const DecodeTable& fallback, unsigned char* out, unsigned int& count) const
+{
+	const MultiDecodeEntry& e = entries[stream.peekBits(bits)];
+
+	if (e.count != 0)
+	{
+		std::memcpy(out, e.symbols, max_symbols);
+		stream.skipBits(e.length);
+		count = e.count;
+		return 0;
+	}
+
+	unsigned int val = fallback.decode(stream);
+	out[0] = static_cast<unsigned char>(val);
+	count = 1;
+	return val;
+}
+
+#endif // YURIKS_MULTI_DECODE_TABLE_H
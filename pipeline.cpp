@@ -0,0 +1,307 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "pipeline.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+
+// Waits for the other side of a queue, yielding at first and then sleeping
+// longer and longer, up to half a millisecond, so an idle thread costs
+// next to nothing.
+class Backoff
+{
+public:
+	Backoff() : rounds(0) {}
+
+	void wait();
+
+private:
+	unsigned int rounds;
+};
+
+void Backoff::wait()
+{
+	if (rounds < 64)
+	{
+		std::this_thread::yield();
+	}
+	else
+	{
+		unsigned int shift = std::min<unsigned int>((rounds - 64) / 16, 6);
+		std::this_thread::sleep_for(std::chrono::microseconds(std::min(10u << shift, 500u)));
+	}
+	++rounds;
+}
+
+void init_buffers(std::vector<PipelineBuffer>& buffers)
+{
+	buffers.resize(PIPELINE_BUFFER_COUNT);
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		buffers[i].data.resize(PIPELINE_BUFFER_SIZE);
+		buffers[i].size = 0;
+		buffers[i].flush = false;
+		buffers[i].end = false;
+	}
+}
+
+// Takes a buffer the other side is handing over, and measures how long the
+// coder waited for it
+PipelineBuffer* wait_pop(SpscQueue<PipelineBuffer*>& queue, Stats* stats, StatsQueue stall)
+{
+	PipelineBuffer* buffer;
+	if (queue.pop(buffer))
+		return buffer;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Backoff backoff;
+	while (!queue.pop(buffer))
+		backoff.wait();
+
+	if (stats != 0)
+	{
+		std::chrono::steady_clock::duration waited = std::chrono::steady_clock::now() - start;
+		stats->addStall(stall, std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+	}
+	return buffer;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+PipelineInputBuf::PipelineInputBuf(std::streambuf* source, Stats* stats)
+	: source(source), stats(stats),
+	filled(PIPELINE_BUFFER_COUNT), free_buffers(PIPELINE_BUFFER_COUNT),
+	current(0), at_end(false), stopping(false)
+{
+	init_buffers(buffers);
+	for (size_t i = 0; i < buffers.size(); ++i)
+		free_buffers.push(&buffers[i]);
+
+	reader = std::thread(&PipelineInputBuf::read, this);
+}
+
+PipelineInputBuf::~PipelineInputBuf()
+{
+	stopping = true;
+	reader.join();
+}
+
+void PipelineInputBuf::read()
+{
+	const std::streambuf::int_type eof = traits_type::eof();
+
+	while (true)
+	{
+		PipelineBuffer* buffer;
+		Backoff backoff;
+		while (!free_buffers.pop(buffer))
+		{
+			if (stopping)
+				return;
+			backoff.wait();
+		}
+
+		buffer->size = 0;
+		buffer->end = false;
+
+		while (buffer->size < buffer->data.size())
+		{
+			std::streamsize ready = source->in_avail();
+
+			// Anything read so far goes out before blocking for more
+			if (ready <= 0 && buffer->size > 0)
+				break;
+			if (ready <= 0 && source->sgetc() == eof)
+			{
+				buffer->end = true;
+				break;
+			}
+
+			std::streamsize n = std::min<std::streamsize>(std::max<std::streamsize>(ready, 1), buffer->data.size() - buffer->size);
+			std::streamsize got = source->sgetn(&buffer->data[buffer->size], n);
+			if (got <= 0)
+			{
+				buffer->end = true;
+				break;
+			}
+			buffer->size += static_cast<size_t>(got);
+		}
+
+		// Never full, it has room for every buffer
+		filled.push(buffer);
+
+		if (buffer->end || stopping)
+			return;
+	}
+}
+
+bool PipelineInputBuf::next(bool wait)
+{
+	while (!at_end)
+	{
+		if (current != 0)
+		{
+			free_buffers.push(current);
+			current = 0;
+			setg(0, 0, 0);
+		}
+
+		if (!wait && filled.size() == 0)
+			return false;
+		current = wait_pop(filled, stats, QUEUE_INPUT);
+		if (stats != 0)
+			stats->sampleQueue(QUEUE_INPUT, static_cast<unsigned int>(filled.size()) + 1);
+
+		at_end = current->end;
+		if (current->size != 0)
+		{
+			char* data = &current->data[0];
+			setg(data, data, data + current->size);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+PipelineInputBuf::int_type PipelineInputBuf::underflow()
+{
+	if (gptr() == egptr() && !next(true))
+		return traits_type::eof();
+
+	return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize PipelineInputBuf::showmanyc()
+{
+	if (next(false))
+		return egptr() - gptr();
+
+	return at_end ? -1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PipelineOutputBuf::PipelineOutputBuf(std::streambuf* sink, Stats* stats)
+	: sink(sink), stats(stats),
+	filled(PIPELINE_BUFFER_COUNT), free_buffers(PIPELINE_BUFFER_COUNT),
+	current(0), closed(false), failed(false)
+{
+	init_buffers(buffers);
+	for (size_t i = 1; i < buffers.size(); ++i)
+		free_buffers.push(&buffers[i]);
+
+	current = &buffers[0];
+	setp(&current->data[0], &current->data[0] + current->data.size());
+
+	writer = std::thread(&PipelineOutputBuf::write, this);
+}
+
+PipelineOutputBuf::~PipelineOutputBuf()
+{
+	close();
+}
+
+bool PipelineOutputBuf::close()
+{
+	if (!closed)
+	{
+		send(true, true);
+		writer.join();
+		closed = true;
+	}
+
+	return !failed;
+}
+
+void PipelineOutputBuf::write()
+{
+	while (true)
+	{
+		PipelineBuffer* buffer;
+		Backoff backoff;
+		while (!filled.pop(buffer))
+			backoff.wait();
+
+		std::streamsize size = static_cast<std::streamsize>(buffer->size);
+		if (size != 0 && !failed && sink->sputn(&buffer->data[0], size) != size)
+			failed = true;
+		if (buffer->flush && !failed && sink->pubsync() != 0)
+			failed = true;
+
+		bool end = buffer->end;
+		free_buffers.push(buffer);
+		if (end)
+			return;
+	}
+}
+
+void PipelineOutputBuf::send(bool flush, bool end)
+{
+	current->size = static_cast<size_t>(pptr() - pbase());
+	current->flush = flush;
+	current->end = end;
+
+	filled.push(current);
+	if (stats != 0)
+		stats->sampleQueue(QUEUE_OUTPUT, static_cast<unsigned int>(filled.size()));
+
+	current = 0;
+	setp(0, 0);
+	if (end)
+		return;
+
+	current = wait_pop(free_buffers, stats, QUEUE_OUTPUT);
+	setp(&current->data[0], &current->data[0] + current->data.size());
+}
+
+PipelineOutputBuf::int_type PipelineOutputBuf::overflow(int_type c)
+{
+	if (closed)
+		return traits_type::eof();
+
+	send(false, false);
+
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+	{
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+int PipelineOutputBuf::sync()
+{
+	if (closed)
+		return failed ? -1 : 0;
+
+	send(true, false);
+	return failed ? -1 : 0;
+}
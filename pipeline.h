@@ -0,0 +1,191 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_PIPELINE_H
+#define YURIKS_PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+class Stats;
+
+// Reading, coding and writing overlap by running the I/O on threads of
+// their own. Fixed buffers go around between the coder and the I/O thread
+// through a pair of queues, one with filled buffers and one with free ones,
+// so nothing is allocated while running. The streambufs below plug into
+// any codec that works on std::istream or std::ostream.
+
+enum
+{
+	PIPELINE_BUFFER_COUNT = 4,
+	PIPELINE_BUFFER_SIZE = 1024 * 1024
+};
+
+// Bounded queue for exactly one producer and one consumer thread. Each
+// side only writes its own index, so it needs no locks.
+template <typename T>
+class SpscQueue
+{
+public:
+	explicit SpscQueue(size_t capacity);
+
+	// Producer side. Returns false if the queue is full.
+	bool push(const T& value);
+	// Consumer side. Returns false if the queue is empty.
+	bool pop(T& value);
+	// Only a hint while the other side is running
+	size_t size() const;
+
+private:
+	SpscQueue(const SpscQueue&);
+	SpscQueue& operator=(const SpscQueue&);
+
+	std::vector<T> slots;
+	std::atomic<size_t> head; // Next to pop
+	std::atomic<size_t> tail; // Next to push
+};
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t capacity)
+	: slots(capacity + 1), head(0), tail(0)
+{
+}
+
+template <typename T>
+bool SpscQueue<T>::push(const T& value)
+{
+	size_t t = tail.load(std::memory_order_relaxed);
+	size_t next = t + 1 == slots.size() ? 0 : t + 1;
+	if (next == head.load(std::memory_order_acquire))
+		return false;
+
+	slots[t] = value;
+	tail.store(next, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+	size_t h = head.load(std::memory_order_relaxed);
+	if (h == tail.load(std::memory_order_acquire))
+		return false;
+
+	value = slots[h];
+	head.store(h + 1 == slots.size() ? 0 : h + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+size_t SpscQueue<T>::size() const
+{
+	size_t h = head.load(std::memory_order_acquire);
+	size_t t = tail.load(std::memory_order_acquire);
+	return t >= h ? t - h : t + slots.size() - h;
+}
+
+struct PipelineBuffer
+{
+	std::vector<char> data;
+	size_t size;
+	// Output: flush the sink after writing it. Input: nothing follows it.
+	bool flush;
+	bool end;
+};
+
+// Reads `source` ahead on a reader thread. Whatever the source has ready
+// is handed over without waiting to fill a buffer, so live input doesn't
+// lag, and in_avail() only counts input that was already read.
+// Reading stops at the end of the source or when the buffer is destroyed,
+// which waits for a read in progress.
+class PipelineInputBuf : public std::streambuf
+{
+public:
+	explicit PipelineInputBuf(std::streambuf* source, Stats* stats = 0);
+	~PipelineInputBuf();
+
+protected:
+	virtual int_type underflow();
+	virtual std::streamsize showmanyc();
+
+private:
+	PipelineInputBuf(const PipelineInputBuf&);
+	PipelineInputBuf& operator=(const PipelineInputBuf&);
+
+	void read();
+	bool next(bool wait);
+
+	std::streambuf* source;
+	Stats* stats;
+
+	std::vector<PipelineBuffer> buffers;
+	SpscQueue<PipelineBuffer*> filled;
+	SpscQueue<PipelineBuffer*> free_buffers;
+	PipelineBuffer* current;
+	bool at_end;
+
+	std::atomic<bool> stopping;
+	std::thread reader;
+};
+
+// Writes to `sink` on a writer thread. sync() queues a flush of the sink
+// behind the data before it, but doesn't wait for it.
+class PipelineOutputBuf : public std::streambuf
+{
+public:
+	explicit PipelineOutputBuf(std::streambuf* sink, Stats* stats = 0);
+	// Closes it if that wasn't done yet
+	~PipelineOutputBuf();
+
+	// Writes out and flushes everything and stops the writer. Returns false
+	// if the sink failed.
+	bool close();
+
+protected:
+	virtual int_type overflow(int_type c);
+	virtual int sync();
+
+private:
+	PipelineOutputBuf(const PipelineOutputBuf&);
+	PipelineOutputBuf& operator=(const PipelineOutputBuf&);
+
+	void write();
+	void send(bool flush, bool end);
+
+	std::streambuf* sink;
+	Stats* stats;
+
+	std::vector<PipelineBuffer> buffers;
+	SpscQueue<PipelineBuffer*> filled;
+	SpscQueue<PipelineBuffer*> free_buffers;
+	PipelineBuffer* current;
+	bool closed;
+
+	std::atomic<bool> failed;
+	std::thread writer;
+};
+
+#endif // YURIKS_PIPELINE_H
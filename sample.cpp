@@ -0,0 +1,178 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "sample.h"
+#include "canonical.h"
+#include "histogram.h"
+
+#include <algorithm>
+#include <istream>
+#include <vector>
+
+namespace
+{
+
+class ChunkPicker
+{
+public:
+	ChunkPicker(unsigned long long size, double fraction);
+
+	// Returns false once every chunk has been picked.
+	bool next(unsigned long long& offset, size_t& length);
+
+private:
+	unsigned long long size;
+	unsigned long long stretch;
+	unsigned long long pos;
+	unsigned long long state;
+};
+
+ChunkPicker::ChunkPicker(unsigned long long size, double fraction)
+	: size(size), stretch(SAMPLE_CHUNK_SIZE), pos(0), state(0x9E3779B97F4A7C15ULL)
+{
+	unsigned long long chunks = static_cast<unsigned long long>(size * std::min(fraction, 1.0) / SAMPLE_CHUNK_SIZE) + 1;
+
+	// Otherwise the chunks are back to back and cover everything
+	if (chunks * SAMPLE_CHUNK_SIZE < size)
+		stretch = size / chunks;
+}
+
+bool ChunkPicker::next(unsigned long long& offset, size_t& length)
+{
+	if (pos >= size)
+		return false;
+
+	offset = pos;
+	length = static_cast<size_t>(std::min<unsigned long long>(SAMPLE_CHUNK_SIZE, size - pos));
+
+	if (stretch == SAMPLE_CHUNK_SIZE)
+	{
+		pos += length;
+		return true;
+	}
+
+	// The remainder of the division goes with the last stretch
+	unsigned long long end = size - pos < 2 * stretch ? size : pos + stretch;
+
+	// xorshift64*
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	offset += (state * 2685821657736338717ULL >> 32) % (end - pos - SAMPLE_CHUNK_SIZE + 1);
+
+	pos = end;
+	return true;
+}
+
+void add_counts(const unsigned char* data, size_t size, unsigned long long* frequency)
+{
+	unsigned long long counts[HISTOGRAM_SIZE];
+	histogram(data, size, counts);
+
+	for (unsigned int i = 0; i < HISTOGRAM_SIZE; ++i)
+		frequency[i] += counts[i];
+}
+
+// Scales the counts of the sample up to the whole input first, so the bytes
+// it missed look as rare as they probably are and get the longest codes
+void smooth(unsigned long long* frequency, unsigned long long sampled, unsigned long long size)
+{
+	const double scale = sampled != 0 ? static_cast<double>(size) / sampled : 1;
+
+	for (unsigned int i = 0; i < HISTOGRAM_SIZE; ++i)
+	{
+		if (frequency[i] == 0)
+			frequency[i] = 1;
+		else
+			frequency[i] = static_cast<unsigned long long>(frequency[i] * scale);
+	}
+
+	frequency[HUFFMAN_EOF] = 1;
+}
+
+} // namespace
+
+unsigned long long sample_frequency(const unsigned char* data, unsigned long long size, double fraction,
+	unsigned long long* frequency, Stats* stats)
+{
+	PhaseTimer timer(stats, PHASE_HISTOGRAM);
+
+	std::fill_n(frequency, HUFFMAN_NUM_SYMBOLS, 0ULL);
+
+	ChunkPicker picker(size, fraction);
+	unsigned long long offset;
+	size_t length;
+	unsigned long long sampled = 0;
+
+	while (picker.next(offset, length))
+	{
+		add_counts(data + offset, length, frequency);
+		sampled += length;
+	}
+
+	smooth(frequency, sampled, size);
+	return sampled;
+}
+
+unsigned long long sample_frequency(std::istream& in, unsigned long long size, double fraction,
+	unsigned long long* frequency, Stats* stats)
+{
+	PhaseTimer timer(stats, PHASE_HISTOGRAM);
+
+	std::fill_n(frequency, HUFFMAN_NUM_SYMBOLS, 0ULL);
+
+	ChunkPicker picker(size, fraction);
+	unsigned long long offset;
+	size_t length;
+	unsigned long long sampled = 0;
+	std::vector<char> buffer(SAMPLE_CHUNK_SIZE);
+
+	while (picker.next(offset, length))
+	{
+		if (!in.seekg(offset) || !in.read(&buffer[0], length))
+			throw std::ios_base::failure("couldn't read the sample");
+
+		add_counts(reinterpret_cast<const unsigned char*>(&buffer[0]), length, frequency);
+		sampled += length;
+	}
+
+	in.seekg(0);
+	smooth(frequency, sampled, size);
+	return sampled;
+}
+
+double code_loss(const unsigned long long* counts, const EncodeTable& code, unsigned int max_length)
+{
+	unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+	build_code_lengths(counts, max_length, lengths);
+
+	double optimal = 0;
+	double actual = 0;
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		optimal += static_cast<double>(counts[i]) * lengths[i];
+		actual += static_cast<double>(counts[i]) * code.codes[i].length;
+	}
+
+	return optimal > 0 ? actual / optimal - 1 : 0;
+}
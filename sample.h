@@ -0,0 +1,62 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_SAMPLE_H
+#define YURIKS_SAMPLE_H
+
+#include "encode_table.h"
+#include "stats.h"
+
+#include <iosfwd>
+
+// Estimates the byte counts of a large input from part of it, so the
+// formats that need a code up front don't have to read the input twice.
+//
+// The sample is read as SAMPLE_CHUNK_SIZE chunks. The input is cut into
+// equal stretches, one per chunk, and each chunk starts at a pseudo-random
+// place in its stretch, so data with a period can't line up with them. The
+// places only depend on the size, so the output doesn't change between
+// runs.
+
+enum
+{
+	SAMPLE_CHUNK_SIZE = 64 * 1024
+};
+
+// Fills in the HUFFMAN_NUM_SYMBOLS counts of about fraction (0 to 1) of
+// the size bytes of input, scaled up to the whole input. Byte values the
+// sample misses still get a count of 1, so every byte can be coded, and
+// EOF gets a count of 1. Returns the number of bytes read.
+unsigned long long sample_frequency(const unsigned char* data, unsigned long long size, double fraction,
+	unsigned long long* frequency, Stats* stats = 0);
+// Same for a seekable stream, which is left at the start.
+// Throws std::ios_base::failure if it can't be read.
+unsigned long long sample_frequency(std::istream& in, unsigned long long size, double fraction,
+	unsigned long long* frequency, Stats* stats = 0);
+
+// How many more bits coding bytes with these counts takes with `code` than
+// with the optimal code for them, none longer than max_length, as a
+// fraction: 0.01 is 1% more.
+double code_loss(const unsigned long long* counts, const EncodeTable& code, unsigned int max_length);
+
+#endif // YURIKS_SAMPLE_H
@@ -0,0 +1,192 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "shared_table.h"
+#include "bitstream.h"
+#include "block.h"
+#include "histogram.h"
+
+#include <atomic>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace
+{
+
+const char SHARED_TABLE_MAGIC[3] = { 'H', 'Z', 'T' };
+
+// FNV-1a over the stored code lengths. 0 is kept for "no table".
+unsigned int table_id(const unsigned char* lengths)
+{
+	unsigned char packed[CODE_LENGTHS_SIZE];
+	OMemoryBitstream stream(packed);
+	write_code_lengths(stream, lengths);
+	stream.finish();
+
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0; i < CODE_LENGTHS_SIZE; ++i)
+		hash = (hash ^ packed[i]) * 16777619u;
+
+	return hash != 0 ? hash : 1;
+}
+
+struct Registry
+{
+	Registry() : generation(0) {}
+
+	std::mutex mutex;
+	std::vector<const SharedTable*> tables;
+	std::atomic<unsigned int> generation;
+};
+
+Registry& registry()
+{
+	static Registry r;
+	return r;
+}
+
+} // namespace
+
+SharedTable::SharedTable(const unsigned long long* counts, unsigned int max_code_length)
+{
+	unsigned long long frequency[HUFFMAN_NUM_SYMBOLS];
+	for (unsigned int i = 0; i < HISTOGRAM_SIZE; ++i)
+		frequency[i] = counts[i] != 0 ? counts[i] : 1;
+	frequency[HUFFMAN_EOF] = 0; // Blocks have their size in the header
+
+	build_code_lengths(frequency, max_code_length, lengths_);
+	init();
+}
+
+SharedTable::SharedTable(const unsigned char* lengths)
+{
+	for (unsigned int i = 0; i < HISTOGRAM_SIZE; ++i)
+	{
+		if (lengths[i] == 0)
+			throw std::ios_base::failure("shared table can't code every byte");
+	}
+
+	std::memcpy(lengths_, lengths, sizeof(lengths_));
+	init();
+}
+
+void SharedTable::init()
+{
+	id_ = table_id(lengths_);
+	encode_table.build(lengths_);
+	decode_table.build(lengths_);
+	multi_decode_table.build(lengths_);
+}
+
+void write_shared_table(std::ostream& out, const SharedTable& table)
+{
+	unsigned char buf[SHARED_TABLE_FILE_SIZE];
+	std::memcpy(buf, SHARED_TABLE_MAGIC, 3);
+	buf[3] = SHARED_TABLE_VERSION;
+	store_u32(buf + 4, table.id());
+
+	OMemoryBitstream stream(buf + 8);
+	write_code_lengths(stream, table.lengths());
+	stream.finish();
+
+	out.write(reinterpret_cast<const char*>(buf), sizeof(buf));
+}
+
+SharedTable read_shared_table(std::istream& in)
+{
+	unsigned char buf[SHARED_TABLE_FILE_SIZE];
+	if (!in.read(reinterpret_cast<char*>(buf), sizeof(buf)))
+		throw std::ios_base::failure("unexpected end of table file");
+
+	if (std::memcmp(buf, SHARED_TABLE_MAGIC, 3) != 0)
+		throw std::ios_base::failure("not a table file");
+	if (buf[3] != SHARED_TABLE_VERSION)
+		throw std::ios_base::failure("unsupported table file version");
+
+	IMemoryBitstream stream(buf + 8, CODE_LENGTHS_SIZE);
+	unsigned char lengths[HUFFMAN_NUM_SYMBOLS];
+	read_code_lengths(stream, lengths);
+
+	SharedTable table(lengths);
+	if (table.id() != load_u32(buf + 4))
+		throw std::ios_base::failure("table file ID doesn't match its code");
+
+	return table;
+}
+
+void register_shared_table(const SharedTable* table)
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	++r.generation;
+
+	for (size_t i = 0; i < r.tables.size(); ++i)
+	{
+		if (r.tables[i]->id() == table->id())
+		{
+			r.tables[i] = table;
+			return;
+		}
+	}
+
+	r.tables.push_back(table);
+}
+
+void unregister_shared_table(const SharedTable* table)
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	for (size_t i = 0; i < r.tables.size(); ++i)
+	{
+		if (r.tables[i] == table)
+		{
+			r.tables.erase(r.tables.begin() + i);
+			++r.generation;
+			return;
+		}
+	}
+}
+
+const SharedTable* find_shared_table(unsigned int id)
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	for (size_t i = 0; i < r.tables.size(); ++i)
+	{
+		if (r.tables[i]->id() == id)
+			return r.tables[i];
+	}
+
+	return 0;
+}
+
+unsigned int shared_table_generation()
+{
+	return registry().generation.load();
+}
@@ -0,0 +1,124 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_SHARED_TABLE_H
+#define YURIKS_SHARED_TABLE_H
+
+#include "canonical.h"
+#include "decode_table.h"
+#include "encode_table.h"
+#include "multi_decode_table.h"
+
+#include <iosfwd>
+
+// A code trained once on sample data and then used for many small inputs,
+// which skip the histogram, the code construction and the code lengths in
+// every block. Blocks refer to the table by its ID, so the decoder must
+// have registered the same table.
+//
+// Table file, version SHARED_TABLE_VERSION:
+//
+//   "HZT", u8 version, u32 ID, code lengths as written by write_code_lengths
+//
+// The ID is a hash of the code lengths, so tables trained to the same code
+// get the same ID.
+
+enum
+{
+	SHARED_TABLE_VERSION = 1,
+	SHARED_TABLE_FILE_SIZE = 8 + CODE_LENGTHS_SIZE
+};
+
+class SharedTable
+{
+public:
+	// Builds the table from byte counts of the sample data. Bytes missing
+	// from the sample still get a code, as if they had appeared once.
+	SharedTable(const unsigned long long* counts, unsigned int max_code_length);
+	// Throws std::ios_base::failure if the lengths don't give every byte a
+	// code.
+	explicit SharedTable(const unsigned char* lengths);
+
+	unsigned int id() const;
+	const unsigned char* lengths() const;
+	const EncodeTable& encodeTable() const;
+	const DecodeTable& decodeTable() const;
+	// Empty if the code is too long for it to help
+	const MultiDecodeTable& multiDecodeTable() const;
+
+private:
+	void init();
+
+	unsigned int id_;
+	unsigned char lengths_[HUFFMAN_NUM_SYMBOLS];
+	EncodeTable encode_table;
+	DecodeTable decode_table;
+	MultiDecodeTable multi_decode_table;
+};
+
+void write_shared_table(std::ostream& out, const SharedTable& table);
+// Throws std::ios_base::failure if the file is truncated, from another
+// version or corrupt.
+SharedTable read_shared_table(std::istream& in);
+
+// Makes table available to blocks that refer to its ID. The table must
+// stay registered while blocks are coded with it, and be unregistered
+// before it is destroyed. Registering a table with the ID of another one
+// replaces it.
+void register_shared_table(const SharedTable* table);
+// Does nothing if table isn't the one registered for its ID.
+void unregister_shared_table(const SharedTable* table);
+// Registered table with this ID, or 0.
+const SharedTable* find_shared_table(unsigned int id);
+// Changes whenever a table is registered or unregistered, so lookups can
+// be kept until it does.
+unsigned int shared_table_generation();
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline unsigned int SharedTable::id() const
+{
+	return id_;
+}
+
+inline const unsigned char* SharedTable::lengths() const
+{
+	return lengths_;
+}
+
+inline const EncodeTable& SharedTable::encodeTable() const
+{
+	return encode_table;
+}
+
+inline const DecodeTable& SharedTable::decodeTable() const
+{
+	return decode_table;
+}
+
+inline const MultiDecodeTable& SharedTable::multiDecodeTable() const
+{
+	return multi_decode_table;
+}
+
+#endif // YURIKS_SHARED_TABLE_H
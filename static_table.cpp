@@ -0,0 +1,101 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "static_table.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace
+{
+
+// TextTable -> YURIKS_TEXT_TABLE_H
+std::string header_guard(const std::string& name)
+{
+	std::string guard = "YURIKS_";
+	for (size_t i = 0; i < name.size(); ++i)
+	{
+		unsigned char c = static_cast<unsigned char>(name[i]);
+		if (i != 0 && std::isupper(c) && std::islower(static_cast<unsigned char>(name[i-1])))
+			guard += '_';
+		guard += static_cast<char>(std::toupper(c));
+	}
+
+	return guard + "_H";
+}
+
+} // namespace
+
+void write_static_table(std::ostream& out, const SharedTable& table, const std::string& name)
+{
+	const unsigned char* lengths = table.lengths();
+	const HuffmanCode* codes = table.encodeTable().codes;
+	const DecodeTable& decode_table = table.decodeTable();
+	const std::vector<DecodeEntry>& entries = decode_table.entryData();
+
+	int max_length = 0;
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		max_length = std::max(max_length, static_cast<int>(lengths[i]));
+
+	const std::string guard = header_guard(name);
+	const std::ios_base::fmtflags flags = out.flags();
+
+	out << "// Made by Huffman.exe --make-header from table " << std::hex << table.id() << std::dec
+		<< ". Make it again\n// instead of editing it.\n";
+	out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+	out << "#include \"static_table.h\"\n\n";
+	out << "struct " << name << "\n{\n";
+	out << "\tstatic const unsigned int id = 0x" << std::hex << table.id() << std::dec << "u;\n";
+	out << "\tstatic const int max_length = " << max_length << ";\n";
+	out << "\tstatic const int root_bits = " << decode_table.rootBits() << ";\n";
+
+	out << "\n\tstatic const unsigned char* lengths()\n\t{\n";
+	out << "\t\tstatic constexpr unsigned char table[HUFFMAN_NUM_SYMBOLS] = {";
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+		out << (i % 16 == 0 ? "\n\t\t\t" : " ") << static_cast<unsigned int>(lengths[i]) << ',';
+	out << "\n\t\t};\n\t\treturn table;\n\t}\n";
+
+	out << "\n\tstatic const HuffmanCode* codes()\n\t{\n";
+	out << "\t\tstatic constexpr HuffmanCode table[HUFFMAN_NUM_SYMBOLS] = {";
+	for (unsigned int i = 0; i < HUFFMAN_NUM_SYMBOLS; ++i)
+	{
+		out << (i % 8 == 0 ? "\n\t\t\t" : " ") << "{ 0x" << std::hex << codes[i].bits << std::dec
+			<< ", " << codes[i].length << " },";
+	}
+	out << "\n\t\t};\n\t\treturn table;\n\t}\n";
+
+	out << "\n\tstatic const DecodeEntry* entries()\n\t{\n";
+	out << "\t\tstatic constexpr DecodeEntry table[" << entries.size() << "] = {";
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		out << (i % 8 == 0 ? "\n\t\t\t" : " ") << "{ " << entries[i].value << ", "
+			<< static_cast<unsigned int>(entries[i].length) << ", " << static_cast<unsigned int>(entries[i].sub_bits) << " },";
+	}
+	out << "\n\t\t};\n\t\treturn table;\n\t}\n";
+
+	out << "};\n\n#endif // " << guard << "\n";
+	out.flags(flags);
+}
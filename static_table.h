@@ -0,0 +1,160 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_STATIC_TABLE_H
+#define YURIKS_STATIC_TABLE_H
+
+#include "decode_table.h"
+#include "encode_table.h"
+#include "shared_table.h"
+
+#include <cstddef>
+#include <ios>
+#include <iosfwd>
+#include <string>
+
+// Coding with a code fixed at compile time, for data that always uses the
+// same one. write_static_table turns a table made by --train into a header
+// declaring a struct with the code and its decode table as constant data,
+// and the templates below are instantiated on that struct, so there is
+// nothing to read or build before coding and the table's sizes are known
+// to the compiler. The struct has:
+//
+//   static const unsigned int id;          // SharedTable::id() of the table
+//   static const int max_length;           // Longest code
+//   static const int root_bits;            // DecodeTable::rootBits()
+//   static const unsigned char* lengths(); // Code lengths, for SharedTable
+//   static const HuffmanCode* codes();     // EncodeTable::codes
+//   static const DecodeEntry* entries();   // DecodeTable::entryData()
+//
+// The coded data is the bare codes of its bytes, with nothing about the
+// code or the size: both ends must use the same table, and the decoder
+// must know how many bytes to decode.
+
+// Writes the header for table, declaring the struct `name`.
+void write_static_table(std::ostream& out, const SharedTable& table, const std::string& name);
+
+template <typename Table, typename Writer>
+void static_encode(Writer& stream, unsigned char byte);
+template <typename Table, typename Reader>
+unsigned char static_decode(Reader& stream);
+
+// Most bytes static_compress can write for size bytes
+template <typename Table>
+size_t static_compress_bound(size_t size);
+// Returns the number of bytes written to out.
+template <typename Table>
+size_t static_compress(const unsigned char* data, size_t size, unsigned char* out);
+// Throws std::ios_base::failure if data ends before raw_size bytes are
+// decoded.
+template <typename Table>
+void static_uncompress(const unsigned char* data, size_t size, unsigned char* out, size_t raw_size);
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace YURIKS_STATIC_TABLE
+{
+
+// Reads bits IMemoryBitstream::fillBuffer has already loaded
+class BufferedBits
+{
+public:
+	explicit BufferedBits(IMemoryBitstream& stream) : stream(stream) {}
+
+	unsigned int peekBits(int n) { return stream.peekBuffered(n); }
+	void skipBits(int n) { stream.skipBits(n); }
+
+private:
+	IMemoryBitstream& stream;
+};
+
+} // namespace YURIKS_STATIC_TABLE
+
+template <typename Table, typename Writer>
+inline void static_encode(Writer& stream, unsigned char byte)
+{
+	const HuffmanCode& code = Table::codes()[byte];
+	stream.pushBits(code.bits, code.length);
+}
+
+template <typename Table, typename Reader>
+inline unsigned char static_decode(Reader& stream)
+{
+	const DecodeEntry* e = &Table::entries()[stream.peekBits(Table::root_bits)];
+
+	// Known at compile time, so tables with a single level don't check
+	if (Table::max_length > Table::root_bits)
+	{
+		while (e->sub_bits != 0)
+		{
+			stream.skipBits(e->length);
+			e = &Table::entries()[e->value + stream.peekBits(e->sub_bits)];
+		}
+	}
+
+	stream.skipBits(e->length);
+	// The tables can code every byte and nothing else
+	return static_cast<unsigned char>(e->value);
+}
+
+template <typename Table>
+inline size_t static_compress_bound(size_t size)
+{
+	return size * Table::max_length / 8 + 8;
+}
+
+template <typename Table>
+size_t static_compress(const unsigned char* data, size_t size, unsigned char* out)
+{
+	OMemoryBitstream stream(out);
+	for (size_t i = 0; i < size; ++i)
+		static_encode<Table>(stream, data[i]);
+
+	return stream.finish();
+}
+
+template <typename Table>
+void static_uncompress(const unsigned char* data, size_t size, unsigned char* out, size_t raw_size)
+{
+	using namespace YURIKS_STATIC_TABLE;
+
+	// A refill leaves room for this many codes of the longest length, sub
+	// tables included, so they are decoded without checking for more bits
+	const size_t per_fill = 56 / Table::max_length;
+
+	IMemoryBitstream stream(data, size);
+	BufferedBits buffered(stream);
+
+	size_t i = 0;
+	for (; i + per_fill <= raw_size; i += per_fill)
+	{
+		stream.fillBuffer();
+		for (size_t k = 0; k < per_fill; ++k)
+			out[i + k] = static_decode<Table>(buffered);
+	}
+
+	for (; i < raw_size; ++i)
+		out[i] = static_decode<Table>(stream);
+}
+
+#endif // YURIKS_STATIC_TABLE_H
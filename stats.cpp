@@ -0,0 +1,87 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "stats.h"
+
+#include <ostream>
+
+namespace
+{
+
+const char* const phase_names[NUM_PHASES] = {
+	"histogram", "tree", "header", "encode", "decode"
+};
+
+const char* const queue_names[NUM_QUEUES] = {
+	"input", "output"
+};
+
+} // namespace
+
+Stats::Stats()
+	: bytes_in(0), bytes_out(0), symbols(0), bits(0),
+	start(std::chrono::steady_clock::now()),
+	progress_callback(0), progress_data(0), progress_interval(0), progress_next(0)
+{
+	for (int i = 0; i < NUM_PHASES; ++i)
+		nanoseconds[i] = 0;
+	for (int i = 0; i < NUM_QUEUES; ++i)
+	{
+		stall_nanoseconds[i] = 0;
+		depth_sum[i] = 0;
+		depth_samples[i] = 0;
+	}
+}
+
+void Stats::setProgress(ProgressCallback callback, void* data, unsigned long long interval)
+{
+	progress_callback = callback;
+	progress_data = data;
+	progress_interval = interval;
+	progress_next = 0;
+}
+
+void Stats::writeJson(std::ostream& s) const
+{
+	std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+	s << "{\n  \"seconds\": " << wall.count() << ",\n  \"phases\": {";
+	for (int i = 0; i < NUM_PHASES; ++i)
+		s << (i == 0 ? "\n" : ",\n") << "    \"" << phase_names[i] << "\": " << nanoseconds[i] / 1e9;
+	s << "\n  },\n";
+
+	// Only with --pipeline, zero otherwise
+	s << "  \"queues\": {";
+	for (int i = 0; i < NUM_QUEUES; ++i)
+	{
+		double depth = depth_samples[i] != 0 ? static_cast<double>(depth_sum[i]) / depth_samples[i] : 0;
+		s << (i == 0 ? "\n" : ",\n") << "    \"" << queue_names[i] << "\": { \"stall\": " << stall_nanoseconds[i] / 1e9
+			<< ", \"depth\": " << depth << " }";
+	}
+	s << "\n  },\n";
+
+	s << "  \"bytes_in\": " << bytes_in << ",\n";
+	s << "  \"bytes_out\": " << bytes_out << ",\n";
+	s << "  \"symbols\": " << symbols << ",\n";
+	s << "  \"bits\": " << bits << "\n}\n";
+}
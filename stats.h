@@ -0,0 +1,167 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_STATS_H
+#define YURIKS_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+
+enum StatsPhase
+{
+	PHASE_HISTOGRAM,
+	PHASE_TREE,   // Trees, code lengths and the tables built from them
+	PHASE_HEADER, // Writing or reading format headers, trees and code lengths
+	PHASE_ENCODE,
+	PHASE_DECODE,
+	NUM_PHASES
+};
+
+// Buffer queues between the coder and the reader and writer threads
+enum StatsQueue
+{
+	QUEUE_INPUT,  // Filled by the reader
+	QUEUE_OUTPUT, // Drained by the writer
+	NUM_QUEUES
+};
+
+// Receives the number of input bytes processed so far and the total, or 0
+// if the total isn't known.
+typedef void (*ProgressCallback)(unsigned long long done, unsigned long long total, void* data);
+
+// Counters filled in by the codec when it's handed one. They are updated
+// once per buffer or block, never per symbol, and nothing is measured when
+// no Stats is given. Phase times from worker threads add up, so their sum
+// can be more than the wall time.
+class Stats
+{
+public:
+	Stats();
+
+	void addTime(StatsPhase phase, unsigned long long nanoseconds);
+	// Time the coder waited on a queue: for input that wasn't read yet, or
+	// for the writer to free a buffer.
+	void addStall(StatsQueue queue, unsigned long long nanoseconds);
+	// Number of buffers waiting in a queue, each time the coder takes one
+	// from it or hands one over.
+	void sampleQueue(StatsQueue queue, unsigned int depth);
+
+	// The callback is called at most once every `interval` input bytes, and
+	// always from the thread that called into the codec.
+	void setProgress(ProgressCallback callback, void* data, unsigned long long interval);
+	void progress(unsigned long long done, unsigned long long total);
+
+	// Wall time since construction, phase times and counters.
+	void writeJson(std::ostream& s) const;
+
+	std::atomic<unsigned long long> bytes_in;
+	std::atomic<unsigned long long> bytes_out;
+	std::atomic<unsigned long long> symbols;
+	// Coded data, without headers
+	std::atomic<unsigned long long> bits;
+
+private:
+	Stats(const Stats&);
+	Stats& operator=(const Stats&);
+
+	std::atomic<unsigned long long> nanoseconds[NUM_PHASES];
+	std::atomic<unsigned long long> stall_nanoseconds[NUM_QUEUES];
+	std::atomic<unsigned long long> depth_sum[NUM_QUEUES];
+	std::atomic<unsigned long long> depth_samples[NUM_QUEUES];
+	std::chrono::steady_clock::time_point start;
+
+	ProgressCallback progress_callback;
+	void* progress_data;
+	unsigned long long progress_interval;
+	unsigned long long progress_next;
+};
+
+inline void Stats::addTime(StatsPhase phase, unsigned long long ns)
+{
+	nanoseconds[phase] += ns;
+}
+
+inline void Stats::addStall(StatsQueue queue, unsigned long long ns)
+{
+	stall_nanoseconds[queue] += ns;
+}
+
+inline void Stats::sampleQueue(StatsQueue queue, unsigned int depth)
+{
+	depth_sum[queue] += depth;
+	++depth_samples[queue];
+}
+
+inline void Stats::progress(unsigned long long done, unsigned long long total)
+{
+	if (progress_callback != 0 && (done >= progress_next || done == total))
+	{
+		progress_next = done + progress_interval;
+		progress_callback(done, total, progress_data);
+	}
+}
+
+// Adds the time until it goes out of scope to a phase. Does nothing
+// without a Stats.
+class PhaseTimer
+{
+public:
+	PhaseTimer(Stats* stats, StatsPhase phase);
+	~PhaseTimer();
+
+	// Ends the phase early
+	void stop();
+
+private:
+	PhaseTimer(const PhaseTimer&);
+	PhaseTimer& operator=(const PhaseTimer&);
+
+	Stats* stats;
+	StatsPhase phase;
+	std::chrono::steady_clock::time_point start;
+};
+
+inline PhaseTimer::PhaseTimer(Stats* stats, StatsPhase phase)
+	: stats(stats), phase(phase)
+{
+	if (stats != 0)
+		start = std::chrono::steady_clock::now();
+}
+
+inline PhaseTimer::~PhaseTimer()
+{
+	stop();
+}
+
+inline void PhaseTimer::stop()
+{
+	if (stats != 0)
+	{
+		std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+		stats->addTime(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		stats = 0;
+	}
+}
+
+#endif // YURIKS_STATS_H
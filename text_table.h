@@ -0,0 +1,342 @@
+// Made by Huffman.exe --make-header from table 758f21f8. Make it again
+// instead of editing it.
+#ifndef YURIKS_TEXT_TABLE_H
+#define YURIKS_TEXT_TABLE_H
+
+#include "static_table.h"
+
+struct TextTable
+{
+	static const unsigned int id = 0x758f21f8u;
+	static const int max_length = 11;
+	static const int root_bits = 11;
+
+	static const unsigned char* lengths()
+	{
+		static constexpr unsigned char table[HUFFMAN_NUM_SYMBOLS] = {
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 6, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			2, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 6, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 4, 6, 7, 6, 4, 5, 9, 4, 5, 11, 10, 7, 8, 5, 4,
+			10, 10, 6, 5, 3, 7, 8, 6, 11, 7, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+			0,
+		};
+		return table;
+	}
+
+	static const HuffmanCode* codes()
+	{
+		static constexpr HuffmanCode table[HUFFMAN_NUM_SYMBOLS] = {
+			{ 0x71a, 11 }, { 0x71b, 11 }, { 0x71c, 11 }, { 0x71d, 11 }, { 0x71e, 11 }, { 0x71f, 11 }, { 0x720, 11 }, { 0x721, 11 },
+			{ 0x722, 11 }, { 0x723, 11 }, { 0x30, 6 }, { 0x724, 11 }, { 0x725, 11 }, { 0x726, 11 }, { 0x727, 11 }, { 0x728, 11 },
+			{ 0x729, 11 }, { 0x72a, 11 }, { 0x72b, 11 }, { 0x72c, 11 }, { 0x72d, 11 }, { 0x72e, 11 }, { 0x72f, 11 }, { 0x730, 11 },
+			{ 0x731, 11 }, { 0x732, 11 }, { 0x733, 11 }, { 0x734, 11 }, { 0x735, 11 }, { 0x736, 11 }, { 0x737, 11 }, { 0x738, 11 },
+			{ 0x0, 2 }, { 0x739, 11 }, { 0x73a, 11 }, { 0x73b, 11 }, { 0x73c, 11 }, { 0x73d, 11 }, { 0x73e, 11 }, { 0x73f, 11 },
+			{ 0x740, 11 }, { 0x741, 11 }, { 0x742, 11 }, { 0x743, 11 }, { 0x31, 6 }, { 0x744, 11 }, { 0x745, 11 }, { 0x746, 11 },
+			{ 0x747, 11 }, { 0x748, 11 }, { 0x749, 11 }, { 0x74a, 11 }, { 0x74b, 11 }, { 0x74c, 11 }, { 0x74d, 11 }, { 0x74e, 11 },
+			{ 0x74f, 11 }, { 0x750, 11 }, { 0x751, 11 }, { 0x752, 11 }, { 0x753, 11 }, { 0x754, 11 }, { 0x755, 11 }, { 0x756, 11 },
+			{ 0x757, 11 }, { 0x758, 11 }, { 0x759, 11 }, { 0x75a, 11 }, { 0x75b, 11 }, { 0x75c, 11 }, { 0x75d, 11 }, { 0x75e, 11 },
+			{ 0x75f, 11 }, { 0x760, 11 }, { 0x761, 11 }, { 0x762, 11 }, { 0x763, 11 }, { 0x764, 11 }, { 0x765, 11 }, { 0x766, 11 },
+			{ 0x767, 11 }, { 0x768, 11 }, { 0x769, 11 }, { 0x76a, 11 }, { 0x76b, 11 }, { 0x76c, 11 }, { 0x76d, 11 }, { 0x76e, 11 },
+			{ 0x76f, 11 }, { 0x770, 11 }, { 0x771, 11 }, { 0x772, 11 }, { 0x773, 11 }, { 0x774, 11 }, { 0x775, 11 }, { 0x776, 11 },
+			{ 0x777, 11 }, { 0x6, 4 }, { 0x32, 6 }, { 0x6c, 7 }, { 0x33, 6 }, { 0x7, 4 }, { 0x14, 5 }, { 0x1c4, 9 },
+			{ 0x8, 4 }, { 0x15, 5 }, { 0x778, 11 }, { 0x38a, 10 }, { 0x6d, 7 }, { 0xe0, 8 }, { 0x16, 5 }, { 0x9, 4 },
+			{ 0x38b, 10 }, { 0x38c, 10 }, { 0x34, 6 }, { 0x17, 5 }, { 0x2, 3 }, { 0x6e, 7 }, { 0xe1, 8 }, { 0x35, 6 },
+			{ 0x779, 11 }, { 0x6f, 7 }, { 0x77a, 11 }, { 0x77b, 11 }, { 0x77c, 11 }, { 0x77d, 11 }, { 0x77e, 11 }, { 0x77f, 11 },
+			{ 0x780, 11 }, { 0x781, 11 }, { 0x782, 11 }, { 0x783, 11 }, { 0x784, 11 }, { 0x785, 11 }, { 0x786, 11 }, { 0x787, 11 },
+			{ 0x788, 11 }, { 0x789, 11 }, { 0x78a, 11 }, { 0x78b, 11 }, { 0x78c, 11 }, { 0x78d, 11 }, { 0x78e, 11 }, { 0x78f, 11 },
+			{ 0x790, 11 }, { 0x791, 11 }, { 0x792, 11 }, { 0x793, 11 }, { 0x794, 11 }, { 0x795, 11 }, { 0x796, 11 }, { 0x797, 11 },
+			{ 0x798, 11 }, { 0x799, 11 }, { 0x79a, 11 }, { 0x79b, 11 }, { 0x79c, 11 }, { 0x79d, 11 }, { 0x79e, 11 }, { 0x79f, 11 },
+			{ 0x7a0, 11 }, { 0x7a1, 11 }, { 0x7a2, 11 }, { 0x7a3, 11 }, { 0x7a4, 11 }, { 0x7a5, 11 }, { 0x7a6, 11 }, { 0x7a7, 11 },
+			{ 0x7a8, 11 }, { 0x7a9, 11 }, { 0x7aa, 11 }, { 0x7ab, 11 }, { 0x7ac, 11 }, { 0x7ad, 11 }, { 0x7ae, 11 }, { 0x7af, 11 },
+			{ 0x7b0, 11 }, { 0x7b1, 11 }, { 0x7b2, 11 }, { 0x7b3, 11 }, { 0x7b4, 11 }, { 0x7b5, 11 }, { 0x7b6, 11 }, { 0x7b7, 11 },
+			{ 0x7b8, 11 }, { 0x7b9, 11 }, { 0x7ba, 11 }, { 0x7bb, 11 }, { 0x7bc, 11 }, { 0x7bd, 11 }, { 0x7be, 11 }, { 0x7bf, 11 },
+			{ 0x7c0, 11 }, { 0x7c1, 11 }, { 0x7c2, 11 }, { 0x7c3, 11 }, { 0x7c4, 11 }, { 0x7c5, 11 }, { 0x7c6, 11 }, { 0x7c7, 11 },
+			{ 0x7c8, 11 }, { 0x7c9, 11 }, { 0x7ca, 11 }, { 0x7cb, 11 }, { 0x7cc, 11 }, { 0x7cd, 11 }, { 0x7ce, 11 }, { 0x7cf, 11 },
+			{ 0x7d0, 11 }, { 0x7d1, 11 }, { 0x7d2, 11 }, { 0x7d3, 11 }, { 0x7d4, 11 }, { 0x7d5, 11 }, { 0x7d6, 11 }, { 0x7d7, 11 },
+			{ 0x7d8, 11 }, { 0x7d9, 11 }, { 0x7da, 11 }, { 0x7db, 11 }, { 0x7dc, 11 }, { 0x7dd, 11 }, { 0x7de, 11 }, { 0x7df, 11 },
+			{ 0x7e0, 11 }, { 0x7e1, 11 }, { 0x7e2, 11 }, { 0x7e3, 11 }, { 0x7e4, 11 }, { 0x7e5, 11 }, { 0x7e6, 11 }, { 0x7e7, 11 },
+			{ 0x7e8, 11 }, { 0x7e9, 11 }, { 0x7ea, 11 }, { 0x7eb, 11 }, { 0x7ec, 11 }, { 0x7ed, 11 }, { 0x7ee, 11 }, { 0x7ef, 11 },
+			{ 0x7f0, 11 }, { 0x7f1, 11 }, { 0x7f2, 11 }, { 0x7f3, 11 }, { 0x7f4, 11 }, { 0x7f5, 11 }, { 0x7f6, 11 }, { 0x7f7, 11 },
+			{ 0x7f8, 11 }, { 0x7f9, 11 }, { 0x7fa, 11 }, { 0x7fb, 11 }, { 0x7fc, 11 }, { 0x7fd, 11 }, { 0x7fe, 11 }, { 0x7ff, 11 },
+			{ 0x0, 0 },
+		};
+		return table;
+	}
+
+	static const DecodeEntry* entries()
+	{
+		static constexpr DecodeEntry table[2048] = {
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 }, { 32, 2, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 }, { 116, 3, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 }, { 97, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 }, { 101, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 }, { 104, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 }, { 111, 4, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 }, { 102, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 }, { 105, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 }, { 110, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 }, { 115, 5, 0 },
+			{ 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 },
+			{ 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 },
+			{ 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 },
+			{ 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 }, { 10, 6, 0 },
+			{ 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 },
+			{ 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 },
+			{ 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 },
+			{ 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 }, { 44, 6, 0 },
+			{ 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 },
+			{ 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 },
+			{ 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 },
+			{ 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 }, { 98, 6, 0 },
+			{ 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 },
+			{ 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 },
+			{ 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 },
+			{ 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 }, { 100, 6, 0 },
+			{ 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 },
+			{ 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 },
+			{ 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 },
+			{ 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 }, { 114, 6, 0 },
+			{ 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 },
+			{ 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 },
+			{ 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 },
+			{ 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 }, { 119, 6, 0 },
+			{ 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 },
+			{ 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 }, { 99, 7, 0 },
+			{ 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 },
+			{ 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 }, { 108, 7, 0 },
+			{ 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 },
+			{ 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 }, { 117, 7, 0 },
+			{ 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 },
+			{ 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 }, { 121, 7, 0 },
+			{ 109, 8, 0 }, { 109, 8, 0 }, { 109, 8, 0 }, { 109, 8, 0 }, { 109, 8, 0 }, { 109, 8, 0 }, { 109, 8, 0 }, { 109, 8, 0 },
+			{ 118, 8, 0 }, { 118, 8, 0 }, { 118, 8, 0 }, { 118, 8, 0 }, { 118, 8, 0 }, { 118, 8, 0 }, { 118, 8, 0 }, { 118, 8, 0 },
+			{ 103, 9, 0 }, { 103, 9, 0 }, { 103, 9, 0 }, { 103, 9, 0 }, { 107, 10, 0 }, { 107, 10, 0 }, { 112, 10, 0 }, { 112, 10, 0 },
+			{ 113, 10, 0 }, { 113, 10, 0 }, { 0, 11, 0 }, { 1, 11, 0 }, { 2, 11, 0 }, { 3, 11, 0 }, { 4, 11, 0 }, { 5, 11, 0 },
+			{ 6, 11, 0 }, { 7, 11, 0 }, { 8, 11, 0 }, { 9, 11, 0 }, { 11, 11, 0 }, { 12, 11, 0 }, { 13, 11, 0 }, { 14, 11, 0 },
+			{ 15, 11, 0 }, { 16, 11, 0 }, { 17, 11, 0 }, { 18, 11, 0 }, { 19, 11, 0 }, { 20, 11, 0 }, { 21, 11, 0 }, { 22, 11, 0 },
+			{ 23, 11, 0 }, { 24, 11, 0 }, { 25, 11, 0 }, { 26, 11, 0 }, { 27, 11, 0 }, { 28, 11, 0 }, { 29, 11, 0 }, { 30, 11, 0 },
+			{ 31, 11, 0 }, { 33, 11, 0 }, { 34, 11, 0 }, { 35, 11, 0 }, { 36, 11, 0 }, { 37, 11, 0 }, { 38, 11, 0 }, { 39, 11, 0 },
+			{ 40, 11, 0 }, { 41, 11, 0 }, { 42, 11, 0 }, { 43, 11, 0 }, { 45, 11, 0 }, { 46, 11, 0 }, { 47, 11, 0 }, { 48, 11, 0 },
+			{ 49, 11, 0 }, { 50, 11, 0 }, { 51, 11, 0 }, { 52, 11, 0 }, { 53, 11, 0 }, { 54, 11, 0 }, { 55, 11, 0 }, { 56, 11, 0 },
+			{ 57, 11, 0 }, { 58, 11, 0 }, { 59, 11, 0 }, { 60, 11, 0 }, { 61, 11, 0 }, { 62, 11, 0 }, { 63, 11, 0 }, { 64, 11, 0 },
+			{ 65, 11, 0 }, { 66, 11, 0 }, { 67, 11, 0 }, { 68, 11, 0 }, { 69, 11, 0 }, { 70, 11, 0 }, { 71, 11, 0 }, { 72, 11, 0 },
+			{ 73, 11, 0 }, { 74, 11, 0 }, { 75, 11, 0 }, { 76, 11, 0 }, { 77, 11, 0 }, { 78, 11, 0 }, { 79, 11, 0 }, { 80, 11, 0 },
+			{ 81, 11, 0 }, { 82, 11, 0 }, { 83, 11, 0 }, { 84, 11, 0 }, { 85, 11, 0 }, { 86, 11, 0 }, { 87, 11, 0 }, { 88, 11, 0 },
+			{ 89, 11, 0 }, { 90, 11, 0 }, { 91, 11, 0 }, { 92, 11, 0 }, { 93, 11, 0 }, { 94, 11, 0 }, { 95, 11, 0 }, { 96, 11, 0 },
+			{ 106, 11, 0 }, { 120, 11, 0 }, { 122, 11, 0 }, { 123, 11, 0 }, { 124, 11, 0 }, { 125, 11, 0 }, { 126, 11, 0 }, { 127, 11, 0 },
+			{ 128, 11, 0 }, { 129, 11, 0 }, { 130, 11, 0 }, { 131, 11, 0 }, { 132, 11, 0 }, { 133, 11, 0 }, { 134, 11, 0 }, { 135, 11, 0 },
+			{ 136, 11, 0 }, { 137, 11, 0 }, { 138, 11, 0 }, { 139, 11, 0 }, { 140, 11, 0 }, { 141, 11, 0 }, { 142, 11, 0 }, { 143, 11, 0 },
+			{ 144, 11, 0 }, { 145, 11, 0 }, { 146, 11, 0 }, { 147, 11, 0 }, { 148, 11, 0 }, { 149, 11, 0 }, { 150, 11, 0 }, { 151, 11, 0 },
+			{ 152, 11, 0 }, { 153, 11, 0 }, { 154, 11, 0 }, { 155, 11, 0 }, { 156, 11, 0 }, { 157, 11, 0 }, { 158, 11, 0 }, { 159, 11, 0 },
+			{ 160, 11, 0 }, { 161, 11, 0 }, { 162, 11, 0 }, { 163, 11, 0 }, { 164, 11, 0 }, { 165, 11, 0 }, { 166, 11, 0 }, { 167, 11, 0 },
+			{ 168, 11, 0 }, { 169, 11, 0 }, { 170, 11, 0 }, { 171, 11, 0 }, { 172, 11, 0 }, { 173, 11, 0 }, { 174, 11, 0 }, { 175, 11, 0 },
+			{ 176, 11, 0 }, { 177, 11, 0 }, { 178, 11, 0 }, { 179, 11, 0 }, { 180, 11, 0 }, { 181, 11, 0 }, { 182, 11, 0 }, { 183, 11, 0 },
+			{ 184, 11, 0 }, { 185, 11, 0 }, { 186, 11, 0 }, { 187, 11, 0 }, { 188, 11, 0 }, { 189, 11, 0 }, { 190, 11, 0 }, { 191, 11, 0 },
+			{ 192, 11, 0 }, { 193, 11, 0 }, { 194, 11, 0 }, { 195, 11, 0 }, { 196, 11, 0 }, { 197, 11, 0 }, { 198, 11, 0 }, { 199, 11, 0 },
+			{ 200, 11, 0 }, { 201, 11, 0 }, { 202, 11, 0 }, { 203, 11, 0 }, { 204, 11, 0 }, { 205, 11, 0 }, { 206, 11, 0 }, { 207, 11, 0 },
+			{ 208, 11, 0 }, { 209, 11, 0 }, { 210, 11, 0 }, { 211, 11, 0 }, { 212, 11, 0 }, { 213, 11, 0 }, { 214, 11, 0 }, { 215, 11, 0 },
+			{ 216, 11, 0 }, { 217, 11, 0 }, { 218, 11, 0 }, { 219, 11, 0 }, { 220, 11, 0 }, { 221, 11, 0 }, { 222, 11, 0 }, { 223, 11, 0 },
+			{ 224, 11, 0 }, { 225, 11, 0 }, { 226, 11, 0 }, { 227, 11, 0 }, { 228, 11, 0 }, { 229, 11, 0 }, { 230, 11, 0 }, { 231, 11, 0 },
+			{ 232, 11, 0 }, { 233, 11, 0 }, { 234, 11, 0 }, { 235, 11, 0 }, { 236, 11, 0 }, { 237, 11, 0 }, { 238, 11, 0 }, { 239, 11, 0 },
+			{ 240, 11, 0 }, { 241, 11, 0 }, { 242, 11, 0 }, { 243, 11, 0 }, { 244, 11, 0 }, { 245, 11, 0 }, { 246, 11, 0 }, { 247, 11, 0 },
+			{ 248, 11, 0 }, { 249, 11, 0 }, { 250, 11, 0 }, { 251, 11, 0 }, { 252, 11, 0 }, { 253, 11, 0 }, { 254, 11, 0 }, { 255, 11, 0 },
+		};
+		return table;
+	}
+};
+
+#endif // YURIKS_TEXT_TABLE_H
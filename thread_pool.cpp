@@ -0,0 +1,241 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned int threads)
+	: stopping(false)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	for (unsigned int i = 0; i < threads; ++i)
+		workers.push_back(std::thread(&ThreadPool::run, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wakeup.notify_all();
+
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+}
+
+void ThreadPool::run()
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (!stopping && tasks.empty())
+				wakeup.wait(lock);
+
+			if (tasks.empty())
+				return;
+
+			task = tasks.front();
+			tasks.pop_front();
+		}
+
+		task();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Set on the pool's own threads, so submit knows which queue is theirs
+thread_local const WorkStealingPool* current_pool = 0;
+thread_local unsigned int current_worker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(unsigned int threads)
+	: next_queue(0), queued(0), pending(0), stopping(false)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	for (unsigned int i = 0; i < threads; ++i)
+		queues.push_back(std::unique_ptr<Queue>(new Queue));
+	for (unsigned int i = 0; i < threads; ++i)
+		workers.push_back(std::thread(&WorkStealingPool::run, this, i));
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (pending != 0)
+			done.wait(lock);
+		stopping = true;
+	}
+	wakeup.notify_all();
+
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+	++pending;
+
+	unsigned int index;
+	if (current_pool == this)
+	{
+		index = current_worker;
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		index = next_queue;
+		next_queue = (next_queue + 1) % size();
+	}
+
+	// Counted before the task can be taken, so a worker's decrement can't
+	// come first and wrap the count. Under the lock, so a worker can't miss
+	// it between checking and waiting.
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++queued;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->tasks.push_back(std::move(task));
+	}
+	wakeup.notify_one();
+}
+
+bool WorkStealingPool::take(unsigned int index, Task& task)
+{
+	{
+		Queue& own = *queues[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			--queued;
+			return true;
+		}
+	}
+
+	for (unsigned int i = 1; i < size(); ++i)
+	{
+		Queue& other = *queues[(index + i) % size()];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.tasks.empty())
+		{
+			task = std::move(other.tasks.front());
+			other.tasks.pop_front();
+			--queued;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void WorkStealingPool::run(unsigned int index)
+{
+	current_pool = this;
+	current_worker = index;
+
+	while (true)
+	{
+		Task task;
+
+		if (take(index, task))
+		{
+			try
+			{
+				task(index);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error)
+					error = std::current_exception();
+			}
+
+			if (--pending == 0)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				done.notify_all();
+			}
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!stopping && queued == 0)
+			wakeup.wait(lock);
+
+		if (stopping)
+			return;
+	}
+}
+
+void WorkStealingPool::wait()
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (pending != 0)
+			done.wait(lock);
+	}
+	rethrow();
+}
+
+bool WorkStealingPool::waitFor(std::chrono::milliseconds timeout)
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!done.wait_for(lock, timeout, [this]() { return pending == 0; }))
+			return false;
+	}
+	rethrow();
+	return true;
+}
+
+void WorkStealingPool::rethrow()
+{
+	std::exception_ptr e;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::swap(e, error);
+	}
+	if (e)
+		std::rethrow_exception(e);
+}
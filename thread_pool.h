@@ -0,0 +1,151 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2010 Yuri K. Schlesner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef YURIKS_THREAD_POOL_H
+#define YURIKS_THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running tasks in submission order.
+class ThreadPool
+{
+public:
+	// 0 threads means one per hardware thread.
+	explicit ThreadPool(unsigned int threads = 0);
+	~ThreadPool();
+
+	unsigned int size() const;
+
+	template <typename F>
+	std::future<typename std::result_of<F()>::type> submit(F task);
+
+private:
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+
+	void run();
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()> > tasks;
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	bool stopping;
+};
+
+inline unsigned int ThreadPool::size() const
+{
+	return static_cast<unsigned int>(workers.size());
+}
+
+template <typename F>
+std::future<typename std::result_of<F()>::type> ThreadPool::submit(F task)
+{
+	typedef typename std::result_of<F()>::type R;
+
+	// std::function needs something copyable
+	std::shared_ptr<std::packaged_task<R()> > packaged(new std::packaged_task<R()>(task));
+	std::future<R> result = packaged->get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back([packaged]() { (*packaged)(); });
+	}
+	wakeup.notify_one();
+
+	return result;
+}
+
+// Worker threads with a task queue each, for tasks that submit more tasks.
+// A worker runs the newest task of its own queue first, so the tasks a task
+// spawns stay on its thread while their data is in cache. Idle workers
+// steal the oldest task of another queue, which is usually the biggest
+// piece of work left.
+class WorkStealingPool
+{
+public:
+	// Gets the index of the worker running it, below size()
+	typedef std::function<void(unsigned int)> Task;
+
+	// 0 threads means one per hardware thread.
+	explicit WorkStealingPool(unsigned int threads = 0);
+	// Waits for the queued tasks.
+	~WorkStealingPool();
+
+	unsigned int size() const;
+
+	// From a task, goes to its worker's queue; from other threads, the
+	// queues take turns.
+	void submit(Task task);
+
+	// Waits until every task, including the ones submitted by tasks, is
+	// done. Rethrows the first exception a task threw.
+	void wait();
+	// Same, but gives up after timeout. Returns true if everything is done.
+	bool waitFor(std::chrono::milliseconds timeout);
+
+private:
+	WorkStealingPool(const WorkStealingPool&);
+	WorkStealingPool& operator=(const WorkStealingPool&);
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void run(unsigned int index);
+	bool take(unsigned int index, Task& task);
+	void rethrow();
+
+	std::vector<std::unique_ptr<Queue> > queues;
+	std::vector<std::thread> workers;
+	unsigned int next_queue;
+
+	// Queued tasks, and tasks queued or running
+	std::atomic<size_t> queued;
+	std::atomic<size_t> pending;
+	std::exception_ptr error;
+
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::condition_variable done;
+	bool stopping;
+};
+
+inline unsigned int WorkStealingPool::size() const
+{
+	// All the queues exist before the first worker starts
+	return static_cast<unsigned int>(queues.size());
+}
+
+#endif // YURIKS_THREAD_POOL_H